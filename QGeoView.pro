@@ -18,4 +18,5 @@ SUBDIRS = \
     samples/mouse-actions \
     samples/camera-actions \
     samples/drag-and-drop \
-    samples/cache
+    samples/cache \
+    tests
@@ -0,0 +1,168 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include <QGeoView/Raster/QGVImage.h>
+
+#include <QBuffer>
+#include <QImage>
+#include <QIODevice>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+
+namespace {
+const int tileSize = 256;
+
+std::atomic<long long> allocations(0);
+
+// same pseudo-random tile on every run, noise keeps PNG close to real tile size
+const QByteArray& tilePng()
+{
+    static const QByteArray data = []() {
+        std::mt19937 random(42);
+        QImage image(tileSize, tileSize, QImage::Format_RGB32);
+        for (int y = 0; y < tileSize; ++y) {
+            for (int x = 0; x < tileSize; ++x) {
+                image.setPixel(x, y, qRgb((x * 3) & 255, (y * 5) & 255, random() & 63));
+            }
+        }
+        QByteArray png;
+        QBuffer buffer(&png);
+        buffer.open(QIODevice::WriteOnly);
+        image.save(&buffer, "PNG");
+        return png;
+    }();
+    return data;
+}
+
+/*!
+ * Sequential read-only device over tile bytes, like finished QNetworkReply.
+ */
+class ReplyDevice : public QIODevice
+{
+public:
+    explicit ReplyDevice(const QByteArray& data)
+        : mData(data)
+        , mPos(0)
+    {
+        open(QIODevice::ReadOnly);
+    }
+
+    bool isSequential() const override
+    {
+        return true;
+    }
+
+    qint64 bytesAvailable() const override
+    {
+        return mData.size() - mPos + QIODevice::bytesAvailable();
+    }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override
+    {
+        const qint64 size = qMin(maxSize, static_cast<qint64>(mData.size()) - mPos);
+        std::memcpy(data, mData.constData() + mPos, static_cast<size_t>(size));
+        mPos += size;
+        return size;
+    }
+
+    qint64 writeData(const char* /*data*/, qint64 /*maxSize*/) override
+    {
+        return -1;
+    }
+
+private:
+    const QByteArray mData;
+    qint64 mPos;
+};
+}
+
+// heap allocations by operator new, pixel and byte buffers of Qt are allocated by malloc and counted separately
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
+
+/*!
+ * Cache disabled: tile is decoded straight from reply device.
+ */
+static void BM_Decode_fromReply(benchmark::State& state)
+{
+    const QByteArray& png = tilePng();
+    long long allocs = 0;
+    for (auto _ : state) {
+        const long long before = allocations.load(std::memory_order_relaxed);
+        ReplyDevice reply(png);
+        QGVImage tile;
+        tile.loadImage(&reply, "png");
+        allocs += allocations.load(std::memory_order_relaxed) - before;
+        benchmark::DoNotOptimize(tile.getImage().constBits());
+    }
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocs), benchmark::Counter::kAvgIterations);
+    state.counters["bufferBytes"] = 0;
+    state.SetBytesProcessed(state.iterations() * png.size());
+}
+BENCHMARK(BM_Decode_fromReply);
+
+/*!
+ * Cache enabled: reply is read to byte array which is shared by cache writer and decoder.
+ * Disk write is left out, it is the same for both ways.
+ */
+static void BM_Decode_readAll(benchmark::State& state)
+{
+    const QByteArray& png = tilePng();
+    long long allocs = 0;
+    long long bufferBytes = 0;
+    for (auto _ : state) {
+        const long long before = allocations.load(std::memory_order_relaxed);
+        ReplyDevice reply(png);
+        const QByteArray rawImage = reply.readAll();
+        bufferBytes += rawImage.capacity();
+        QGVImage tile;
+        tile.loadImage(rawImage);
+        allocs += allocations.load(std::memory_order_relaxed) - before;
+        benchmark::DoNotOptimize(tile.getImage().constBits());
+    }
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocs), benchmark::Counter::kAvgIterations);
+    state.counters["bufferBytes"] = benchmark::Counter(static_cast<double>(bufferBytes), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * png.size());
+}
+BENCHMARK(BM_Decode_readAll);
+
+BENCHMARK_MAIN();
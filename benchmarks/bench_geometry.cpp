@@ -0,0 +1,200 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include <QGeoView/QGVGlobal.h>
+#include <QGeoView/QGVProjectionEPSG3857.h>
+
+#include <QVector>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace {
+const int inputSize = 1024;
+const int inputMask = inputSize - 1;
+const int tileZoom = 15;
+
+// same pseudo-random input on every run, so results are comparable over time
+struct Input
+{
+    Input()
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<double> latRandom(-85.0, 85.0);
+        std::uniform_real_distribution<double> lonRandom(-180.0, 180.0);
+        for (int index = 0; index < inputSize; ++index) {
+            const QGV::GeoPos pos(latRandom(random), lonRandom(random));
+            geoPos.append(pos);
+            geoRects.append(QGV::GeoRect(pos, QGV::GeoPos(pos.latitude() - 5.0, pos.longitude() + 5.0)));
+            tiles.append(QGV::GeoTilePos::geoToTilePos(tileZoom, pos));
+            parents.append(tiles.last().parent(tileZoom - 5));
+            projPos.append(projection.geoToProj(pos));
+            lat.append(pos.latitude());
+            lon.append(pos.longitude());
+        }
+    }
+
+    QGVProjectionEPSG3857 projection;
+    QVector<QGV::GeoPos> geoPos;
+    QVector<QGV::GeoRect> geoRects;
+    QVector<QGV::GeoTilePos> tiles;
+    QVector<QGV::GeoTilePos> parents;
+    QVector<QPointF> projPos;
+    QVector<double> lat;
+    QVector<double> lon;
+};
+
+const Input& input()
+{
+    static const Input data;
+    return data;
+}
+}
+
+static void BM_GeoTilePos_geoToTilePos(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(QGV::GeoTilePos::geoToTilePos(tileZoom, in.geoPos[index++ & inputMask]));
+    }
+}
+BENCHMARK(BM_GeoTilePos_geoToTilePos);
+
+static void BM_GeoTilePos_parent(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.tiles[index++ & inputMask].parent(tileZoom - 5));
+    }
+}
+BENCHMARK(BM_GeoTilePos_parent);
+
+static void BM_GeoTilePos_contains(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.parents[index & inputMask].contains(in.tiles[(index + 1) & inputMask]));
+        ++index;
+    }
+}
+BENCHMARK(BM_GeoTilePos_contains);
+
+static void BM_GeoTilePos_toQuadKey(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.tiles[index++ & inputMask].toQuadKey());
+    }
+}
+BENCHMARK(BM_GeoTilePos_toQuadKey);
+
+static void BM_GeoTilePos_toGeoRect(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.tiles[index++ & inputMask].toGeoRect());
+    }
+}
+BENCHMARK(BM_GeoTilePos_toGeoRect);
+
+static void BM_EPSG3857_geoToProj(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.projection.geoToProj(in.geoPos[index++ & inputMask]));
+    }
+}
+BENCHMARK(BM_EPSG3857_geoToProj);
+
+static void BM_EPSG3857_geoToProjArray(benchmark::State& state)
+{
+    const Input& in = input();
+    QVector<double> x(inputSize);
+    QVector<double> y(inputSize);
+    for (auto _ : state) {
+        in.projection.geoToProjArray(in.lat.constData(), in.lon.constData(), x.data(), y.data(), inputSize);
+        benchmark::DoNotOptimize(x.data());
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * inputSize);
+}
+BENCHMARK(BM_EPSG3857_geoToProjArray);
+
+static void BM_EPSG3857_projToGeo(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.projection.projToGeo(in.projPos[index++ & inputMask]));
+    }
+}
+BENCHMARK(BM_EPSG3857_projToGeo);
+
+static void BM_EPSG3857_geodesicMeters(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+                in.projection.geodesicMeters(in.projPos[index & inputMask], in.projPos[(index + 1) & inputMask]));
+        ++index;
+    }
+}
+BENCHMARK(BM_EPSG3857_geodesicMeters);
+
+static void BM_GeoRect_intersects(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.geoRects[index & inputMask].intersects(in.geoRects[(index + 1) & inputMask]));
+        ++index;
+    }
+}
+BENCHMARK(BM_GeoRect_intersects);
+
+static void BM_createTransfrom(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(QGV::createTransfrom(in.projPos[index & inputMask], 1.5, index & 255));
+        ++index;
+    }
+}
+BENCHMARK(BM_createTransfrom);
+
+static void BM_GeoPos_lonToString(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.geoPos[index++ & inputMask].lonToString());
+    }
+}
+BENCHMARK(BM_GeoPos_lonToString);
+
+BENCHMARK_MAIN();
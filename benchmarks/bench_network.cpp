@@ -0,0 +1,165 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "stubserver.h"
+#include "testitems.h"
+
+#include <QGeoView/QGVMap.h>
+
+#include <QApplication>
+#include <QEventLoop>
+#include <QNetworkAccessManager>
+#include <QTimer>
+#include <QtMath>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+const QSize viewSize = QSize(1024, 1024);
+const int viewZoom = 5;
+const int loadTimeoutMs = 60000;
+const char* http2UrlVariable = "QGV_BENCHMARK_HTTP2_URL";
+
+/*!
+ * Map with one view of tiles, the same one as map tests use.
+ */
+QGVMap* benchmarkMap()
+{
+    static QGVMap* map = []() {
+        auto result = new QGVMap();
+        result->resize(viewSize);
+        result->show();
+        QCoreApplication::processEvents();
+        const QPointF center = result->getProjection()->geoToProj(QGV::GeoPos(50, 10));
+        result->cameraTo(QGVCameraActions(result).scaleTo(qPow(2.0, viewZoom - 17)).moveTo(center));
+        return result;
+    }();
+    return map;
+}
+
+bool isLoaded(const TestMirrorTiles* layer)
+{
+    return layer->countPendingTiles() == 0 && layer->countRequestsInFlight() == 0;
+}
+
+/*!
+ * Fresh layer loads the whole view, so requests are built by QGVLayerTilesOnline itself
+ * with its HTTP/2, connections per host and keep-alive settings.
+ */
+bool loadView(TestMirrorTiles* layer)
+{
+    QGVMap* map = benchmarkMap();
+    map->addItem(layer);
+    QEventLoop loop;
+    QTimer poll;
+    QObject::connect(&poll, &QTimer::timeout, &loop, [layer, &loop]() {
+        if (isLoaded(layer)) {
+            loop.quit();
+        }
+    });
+    QTimer::singleShot(loadTimeoutMs, &loop, [&loop]() { loop.exit(1); });
+    poll.start(1);
+    const bool loaded = (loop.exec() == 0);
+    map->deleteItems();
+    return loaded;
+}
+
+TestMirrorTiles* createLayer(const QString& baseUrl, QNetworkAccessManager* manager)
+{
+    auto layer = new TestMirrorTiles(QStringList() << baseUrl);
+    layer->setCache(false);
+    layer->setAutoOffline(false);
+    layer->setNetworkManager(manager);
+    return layer;
+}
+}
+
+/*!
+ * HTTP/1.1 against local stub server, arguments are reply delay in ms and connections per host
+ * (zero keeps Qt default, other values need Qt 6.5).
+ */
+static void BM_LoadView_http1(benchmark::State& state)
+{
+    StubServer server;
+    if (!server.listen()) {
+        state.SkipWithError("stub server can't listen");
+        return;
+    }
+    server.setDelayMs(static_cast<int>(state.range(0)));
+    QNetworkAccessManager manager;
+    for (auto _ : state) {
+        TestMirrorTiles* layer = createLayer(server.baseUrl(), &manager);
+        layer->setHttp2(false);
+        layer->setConnectionsPerHost(static_cast<int>(state.range(1)));
+        if (!loadView(layer)) {
+            state.SkipWithError("view is not loaded in time");
+            return;
+        }
+    }
+    // visible tiles and prefetched neighbours
+    state.SetItemsProcessed(server.requests());
+}
+BENCHMARK(BM_LoadView_http1)
+        ->Args({ 0, 0 })
+        ->Args({ 20, 0 })
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+        ->Args({ 20, 1 })
+        ->Args({ 20, 16 })
+#endif
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+/*!
+ * HTTP/2 multiplexing needs server which speaks HTTP/2, stub server speaks HTTP/1.1 only.
+ * Url of local HTTP/2 tile server is given by QGV_BENCHMARK_HTTP2_URL, for example https://localhost:8443.
+ */
+static void BM_LoadView_http2(benchmark::State& state)
+{
+    const QString baseUrl = qEnvironmentVariable(http2UrlVariable);
+    if (baseUrl.isEmpty()) {
+        state.SkipWithError("QGV_BENCHMARK_HTTP2_URL is not set");
+        return;
+    }
+    QNetworkAccessManager manager;
+    for (auto _ : state) {
+        TestMirrorTiles* layer = createLayer(baseUrl, &manager);
+        layer->setHttp2(true);
+        if (!loadView(layer)) {
+            state.SkipWithError("view is not loaded in time");
+            return;
+        }
+    }
+}
+BENCHMARK(BM_LoadView_http2)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+int main(int argc, char* argv[])
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    // map is a widget, so benchmark runs without display like tests do
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    delete benchmarkMap();
+    return 0;
+}
@@ -0,0 +1,195 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include <QGeoView/QGVGlobal.h>
+
+#include <QVector>
+#include <QtMath>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace {
+const int inputSize = 1024;
+const int inputMask = inputSize - 1;
+const int tileZoom = 15;
+const int parentZoom = tileZoom - 5;
+
+struct Input
+{
+    Input()
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<double> latRandom(-85.0, 85.0);
+        std::uniform_real_distribution<double> lonRandom(-180.0, 180.0);
+        for (int index = 0; index < inputSize; ++index) {
+            const QGV::GeoPos pos(latRandom(random), lonRandom(random));
+            geoPos.append(pos);
+            tiles.append(QGV::GeoTilePos::geoToTilePos(tileZoom, pos));
+            parents.append(tiles.last().parent(parentZoom));
+            mortons.append(tiles.last().toMorton());
+        }
+    }
+
+    QVector<QGV::GeoPos> geoPos;
+    QVector<QGV::GeoTilePos> tiles;
+    QVector<QGV::GeoTilePos> parents;
+    QVector<quint64> mortons;
+};
+
+const Input& input()
+{
+    static const Input data;
+    return data;
+}
+
+// floating point tile math which was used before integer one, kept as baseline for comparison
+QGV::GeoTilePos parentPow(const QGV::GeoTilePos& tilePos, int zoom)
+{
+    if (zoom >= tilePos.zoom()) {
+        return QGV::GeoTilePos();
+    }
+    const int factor = static_cast<int>(qPow(2, tilePos.zoom() - zoom));
+    const int x = static_cast<int>(qFloor(tilePos.pos().x() / factor));
+    const int y = static_cast<int>(qFloor(tilePos.pos().y() / factor));
+    return QGV::GeoTilePos(zoom, QPoint(x, y));
+}
+
+bool containsPow(const QGV::GeoTilePos& tilePos, const QGV::GeoTilePos& other)
+{
+    if (tilePos.zoom() >= other.zoom()) {
+        return false;
+    }
+    return parentPow(other, tilePos.zoom()).pos() == tilePos.pos();
+}
+
+QGV::GeoTilePos geoToTilePosPow(int zoom, const QGV::GeoPos& geoPos)
+{
+    const double lon = geoPos.longitude();
+    const double lat = geoPos.latitude();
+    const double x = floor((lon + 180.0) / 360.0 * pow(2.0, zoom));
+    const double y =
+            floor((1.0 - log(tan(lat * M_PI / 180.0) + 1.0 / cos(lat * M_PI / 180.0)) / M_PI) / 2.0 * pow(2.0, zoom));
+    return QGV::GeoTilePos(zoom, QPoint(static_cast<int>(x), static_cast<int>(y)));
+}
+}
+
+static void BM_TileMath_parent_pow(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parentPow(in.tiles[index++ & inputMask], parentZoom));
+    }
+}
+BENCHMARK(BM_TileMath_parent_pow);
+
+static void BM_TileMath_parent_shift(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.tiles[index++ & inputMask].parent(parentZoom));
+    }
+}
+BENCHMARK(BM_TileMath_parent_shift);
+
+static void BM_TileMath_contains_pow(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(containsPow(in.parents[index & inputMask], in.tiles[(index + 1) & inputMask]));
+        ++index;
+    }
+}
+BENCHMARK(BM_TileMath_contains_pow);
+
+static void BM_TileMath_contains_shift(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.parents[index & inputMask].contains(in.tiles[(index + 1) & inputMask]));
+        ++index;
+    }
+}
+BENCHMARK(BM_TileMath_contains_shift);
+
+static void BM_TileMath_geoToTilePos_pow(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(geoToTilePosPow(tileZoom, in.geoPos[index++ & inputMask]));
+    }
+}
+BENCHMARK(BM_TileMath_geoToTilePos_pow);
+
+static void BM_TileMath_geoToTilePos(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(QGV::GeoTilePos::geoToTilePos(tileZoom, in.geoPos[index++ & inputMask]));
+    }
+}
+BENCHMARK(BM_TileMath_geoToTilePos);
+
+static void BM_TileMath_geoToTilePos_batch(benchmark::State& state)
+{
+    const Input& in = input();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(QGV::GeoTilePos::geoToTilePos(tileZoom, in.geoPos));
+    }
+    state.SetItemsProcessed(state.iterations() * inputSize);
+}
+BENCHMARK(BM_TileMath_geoToTilePos_batch);
+
+static void BM_TileMath_toMorton(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.tiles[index++ & inputMask].toMorton());
+    }
+}
+BENCHMARK(BM_TileMath_toMorton);
+
+static void BM_TileMath_fromMorton(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(QGV::GeoTilePos::fromMorton(tileZoom, in.mortons[index++ & inputMask]));
+    }
+}
+BENCHMARK(BM_TileMath_fromMorton);
+
+static void BM_TileMath_toId(benchmark::State& state)
+{
+    const Input& in = input();
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(in.tiles[index++ & inputMask].toId());
+    }
+}
+BENCHMARK(BM_TileMath_toId);
+
+BENCHMARK_MAIN();
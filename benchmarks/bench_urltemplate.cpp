@@ -0,0 +1,121 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include <QGeoView/QGVGlobal.h>
+#include <QGeoView/QGVUrlTemplate.h>
+
+#include <QVector>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace {
+const int tilesCount = 1000000;
+const int tileZoom = 17;
+const QString osmUrl = "https://tile.openstreetmap.org/${z}/${x}/${y}.png";
+const QString bingUrl = "http://ecn.t1.tiles.virtualearth.net/tiles/r${qk}.jpeg?g=685&mkt=${lcl}";
+const QString locale = "en_US";
+
+// one million tiles of one zoom level, same on every run
+const QVector<QGV::GeoTilePos>& tiles()
+{
+    static const QVector<QGV::GeoTilePos> data = []() {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> posRandom(0, QGV::tilesPerSide(tileZoom) - 1);
+        QVector<QGV::GeoTilePos> result;
+        result.reserve(tilesCount);
+        for (int index = 0; index < tilesCount; ++index) {
+            result.append(QGV::GeoTilePos(tileZoom, QPoint(posRandom(random), posRandom(random))));
+        }
+        return result;
+    }();
+    return data;
+}
+
+// per tile replace passes which were used by layers before url templates, kept as baseline for comparison
+QString osmReplace(const QGV::GeoTilePos& tilePos)
+{
+    QString url = osmUrl.toLower();
+    url.replace("${z}", QString::number(tilePos.zoom()));
+    url.replace("${x}", QString::number(tilePos.pos().x()));
+    url.replace("${y}", QString::number(tilePos.pos().y()));
+    return url;
+}
+
+QString bingReplace(const QGV::GeoTilePos& tilePos)
+{
+    QString url = bingUrl.toLower();
+    url.replace("${lcl}", locale);
+    url.replace("${qk}", tilePos.toQuadKey());
+    return url;
+}
+}
+
+static void BM_UrlTemplate_osm_replace(benchmark::State& state)
+{
+    const QVector<QGV::GeoTilePos>& input = tiles();
+    for (auto _ : state) {
+        for (const QGV::GeoTilePos& tilePos : input) {
+            benchmark::DoNotOptimize(osmReplace(tilePos));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_UrlTemplate_osm_replace)->Unit(benchmark::kMillisecond);
+
+static void BM_UrlTemplate_osm(benchmark::State& state)
+{
+    const QVector<QGV::GeoTilePos>& input = tiles();
+    const QGVUrlTemplate urlTemplate(osmUrl);
+    for (auto _ : state) {
+        for (const QGV::GeoTilePos& tilePos : input) {
+            benchmark::DoNotOptimize(urlTemplate.toUrl(tilePos));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_UrlTemplate_osm)->Unit(benchmark::kMillisecond);
+
+static void BM_UrlTemplate_bing_replace(benchmark::State& state)
+{
+    const QVector<QGV::GeoTilePos>& input = tiles();
+    for (auto _ : state) {
+        for (const QGV::GeoTilePos& tilePos : input) {
+            benchmark::DoNotOptimize(bingReplace(tilePos));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_UrlTemplate_bing_replace)->Unit(benchmark::kMillisecond);
+
+static void BM_UrlTemplate_bing(benchmark::State& state)
+{
+    const QVector<QGV::GeoTilePos>& input = tiles();
+    QGVUrlTemplate urlTemplate(bingUrl, { "lcl" });
+    urlTemplate.bind("lcl", locale);
+    for (auto _ : state) {
+        for (const QGV::GeoTilePos& tilePos : input) {
+            benchmark::DoNotOptimize(urlTemplate.toUrl(tilePos));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(BM_UrlTemplate_bing)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -93,6 +93,7 @@ public:
     void setDuration(int msecs);
     int duration() const override;
     QGVCameraActions& actions();
+    QList<QGVCameraState> trajectory(int samples);
 
 protected:
     virtual void onStart();
@@ -40,6 +40,9 @@ public:
     void repaint();
     void resetBoundary();
     QTransform effectiveTransform() const;
+    int getUpdateCount() const;
+    int getPaintCount() const;
+    int getShapeCount() const;
 
     virtual QPainterPath projShape() const = 0;
     virtual void projPaint(QPainter* painter) = 0;
@@ -64,4 +67,5 @@ private:
     QGV::ItemFlags mFlags;
     QScopedPointer<QGVMapQGItem> mQGDrawItem;
     bool mDirty;
+    int mUpdateCount;
 };
@@ -23,6 +23,7 @@
 #include <QPainterPath>
 #include <QPointF>
 #include <QRectF>
+#include <QVector>
 
 #ifndef QGV_LIB_DECL
 #if defined(QGV_EXPORT)
@@ -37,6 +38,7 @@ namespace QGV {
 enum class Projection
 {
     EPSG3857,
+    EPSG4326,
 };
 
 enum class TilesType
@@ -149,11 +151,24 @@ public:
     bool contains(GeoRect const& rect) const;
     bool intersects(GeoRect const& rect) const;
 
+    bool containsWrapped(GeoPos const& pos) const;
+    bool intersectsWrapped(GeoRect const& rect) const;
+    static QVector<GeoRect> fromWestEast(double lat1, double lonWest, double lat2, double lonEast);
+
+    static QVector<int> filterContains(const QVector<GeoRect>& rects, GeoPos const& pos);
+    static QVector<int> filterIntersects(const QVector<GeoRect>& rects, GeoRect const& rect);
+
 private:
     GeoPos mTopLeft;
     GeoPos mBottomRight;
 };
 
+/*
+ * 64-bit tile identifier. Morton code of tile is aligned to zoom level 28 and followed by zoom, so ids are ordered
+ * in pre-order of tiles tree: tile is followed by all its descendants, which form contiguous range of ids.
+ */
+using GeoTileId = quint64;
+
 class QGV_LIB_DECL GeoTilePos
 {
 public:
@@ -165,23 +180,43 @@ public:
     GeoTilePos& operator=(const GeoTilePos&& other);
 
     bool operator<(const GeoTilePos& other) const;
+    bool operator==(const GeoTilePos& other) const;
 
     int zoom() const;
     QPoint pos() const;
 
     bool contains(const GeoTilePos& other) const;
     GeoTilePos parent(int parentZoom) const;
+    GeoTilePos child(int childZoom, const QPoint& offset) const;
 
     GeoRect toGeoRect() const;
     QString toQuadKey() const;
+    quint64 toMorton() const;
+    GeoTileId toId() const;
+    GeoTileId descendantsIdEnd() const;
 
+    static GeoTilePos fromQuadKey(const QString& quadKey);
+    static GeoTilePos fromMorton(int zoom, quint64 morton);
+    static GeoTilePos fromId(GeoTileId id);
     static GeoTilePos geoToTilePos(int zoom, const GeoPos& geoPos);
+    static QVector<GeoTilePos> geoToTilePos(int zoom, const QVector<GeoPos>& geoPos);
 
 private:
     int mZoom;
     QPoint mPos;
 };
 
+constexpr int tilesPerSide(int zoom)
+{
+    return 1 << zoom;
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+QGV_LIB_DECL size_t qHash(const GeoTilePos& key, size_t seed = 0);
+#else
+QGV_LIB_DECL uint qHash(const GeoTilePos& key, uint seed = 0);
+#endif
+
 QGV_LIB_DECL void setNetworkManager(QNetworkAccessManager* manager);
 QGV_LIB_DECL QNetworkAccessManager* getNetworkManager();
 
@@ -71,12 +71,19 @@ public:
 
     void update();
 
+    virtual void onProjectionPrepare(const QGVProjection* projection);
+    virtual int projectionCost() const;
     virtual void onProjection(QGVMap* geoMap);
     virtual void onCamera(const QGVCameraState& oldState, const QGVCameraState& newState);
+    virtual void onTrajectory(const QList<QGVCameraState>& states);
     virtual void onUpdate();
     virtual void onClean();
 
+protected:
+    bool isProjectionPrepared() const;
+
 private:
+    friend class QGVMap;
     Q_DISABLE_COPY(QGVItem)
     QGVItem* mParent;
     qint16 mZValue;
@@ -84,5 +91,6 @@ private:
     bool mVisible;
     bool mSelectable;
     bool mSelected;
+    bool mProjectionPrepared;
     QList<QGVItem*> mChildrens;
 };
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "QGVLayerTilesOnline.h"
+#include "QGVUrlTemplate.h"
 
 class QGV_LIB_DECL QGVLayerBDGEx : public QGVLayerTilesOnline
 {
@@ -38,4 +39,5 @@ private:
 
 private:
     QString mUrl;
+    QGVUrlTemplate mUrlTemplate;
 };
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "QGVLayerTilesOnline.h"
+#include "QGVUrlTemplate.h"
 
 class QGV_LIB_DECL QGVLayerBing : public QGVLayerTilesOnline
 {
@@ -37,12 +38,16 @@ public:
 
 private:
     void createName();
+    void createUrl();
     int minZoomlevel() const override;
     int maxZoomlevel() const override;
     QString tilePosToUrl(const QGV::GeoTilePos& tilePos) const override;
+    int mirrorsCount() const override;
+    QString tilePosToMirrorUrl(const QGV::GeoTilePos& tilePos, int mirror) const override;
 
 private:
     QGV::TilesType mType;
     QLocale mLocale;
     int mServerNumber;
+    QVector<QGVUrlTemplate> mUrlTemplates;
 };
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "QGVLayerTilesOnline.h"
+#include "QGVUrlTemplate.h"
 
 class QGV_LIB_DECL QGVLayerOSM : public QGVLayerTilesOnline
 {
@@ -30,12 +31,26 @@ public:
 
     void setUrl(const QString& url);
     QString getUrl() const;
+    void setRetinaUrl(const QString& url, int tilePixelSize = 512);
+    QString getRetinaUrl() const;
+    void setMirrorUrls(const QStringList& urls);
+    QStringList getMirrorUrls() const;
 
 private:
     int minZoomlevel() const override;
     int maxZoomlevel() const override;
+    int tilePixelSize() const override;
     QString tilePosToUrl(const QGV::GeoTilePos& tilePos) const override;
+    int mirrorsCount() const override;
+    QString tilePosToMirrorUrl(const QGV::GeoTilePos& tilePos, int mirror) const override;
+    bool isRetina() const;
 
 private:
     QString mUrl;
+    QString mRetinaUrl;
+    QGVUrlTemplate mUrlTemplate;
+    QGVUrlTemplate mRetinaUrlTemplate;
+    QStringList mMirrorUrls;
+    QVector<QGVUrlTemplate> mMirrorTemplates;
+    int mRetinaTilePixelSize;
 };
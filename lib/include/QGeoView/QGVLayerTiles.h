@@ -19,8 +19,14 @@
 #pragma once
 
 #include "QGVLayer.h"
+#include "QGVTileGrid.h"
 
+#include <QCache>
 #include <QElapsedTimer>
+#include <QImage>
+#include <QSet>
+
+class QGVImage;
 
 class QGV_LIB_DECL QGVLayerTiles : public QGVLayer
 {
@@ -35,10 +41,22 @@ public:
     void setVisibleZoomLayersBelowCurrent(size_t value);
     void setVisibleZoomLayersAboveCurrent(size_t value);
     void setCameraUpdatesDuringAnimation(bool value);
+    void setPrefetchTrajectory(bool value);
+    void setPrefetchVelocity(bool value);
+    void setPrefetchLookaheadMs(size_t value);
+    void setPrefetchMaxTiles(size_t value);
+    void setParentPlaceholders(bool value);
+    void setOverzoomLevels(size_t value);
+    void setOpaqueTiles(bool value);
+    void setTilePixelSize(int value);
+
+    int countPendingTiles() const;
+    virtual int countRequestsInFlight() const;
 
 protected:
     void onProjection(QGVMap* geoMap) override;
     void onCamera(const QGVCameraState& oldState, const QGVCameraState& newState) override;
+    void onTrajectory(const QList<QGVCameraState>& states) override;
     void onUpdate() override;
     void onClean() override;
     void onTile(const QGV::GeoTilePos& tilePos, QGVDrawItem* tileObj);
@@ -46,26 +64,65 @@ protected:
     virtual int minZoomlevel() const = 0;
     virtual int maxZoomlevel() const = 0;
     virtual int scaleToZoom(double scale) const;
+    virtual int tilePixelSize() const;
+    double devicePixelRatio() const;
+    void setTileGrid(const QGVTileGrid& tileGrid);
+    const QGVTileGrid& getTileGrid() const;
+    void setTileGeometry(QGVImage* tile, const QGV::GeoTilePos& tilePos) const;
+    bool isOpaqueTiles() const;
     virtual void request(const QGV::GeoTilePos& tilePos) = 0;
     virtual void cancel(const QGV::GeoTilePos& tilePos) = 0;
+    virtual void prefetch(const QGV::GeoTilePos& tilePos);
+    virtual void abortPrefetch(const QSet<QGV::GeoTilePos>& keep);
+    virtual QGVDrawItem* placeholder(const QGV::GeoTilePos& tilePos);
+    virtual QImage decodedTile(const QGV::GeoTilePos& tilePos);
+    void storeDecoded(const QGV::GeoTilePos& tilePos, const QImage& image);
+    QGVDrawItem* overzoom(const QGV::GeoTilePos& tilePos);
 
 private:
     void processCamera();
+    void processVelocity(const QGVCameraState& oldState, const QGVCameraState& newState);
+    void prefetchArea(int zoom, const QRectF& projRect, QList<QGV::GeoTilePos>& planned);
+    void prefetchTiles(const QList<QGV::GeoTilePos>& planned);
+    QRect tilesRect(int zoom, const QRectF& projRect) const;
+    int maxOverzoomlevel() const;
+    QGVDrawItem* cropTile(const QGV::GeoTilePos& tilePos,
+                          const QGV::GeoTilePos& ancestor,
+                          const QImage& image,
+                          int minPixels,
+                          const QString& kind) const;
     void removeAllAbove(const QGV::GeoTilePos& tilePos);
     void removeWhenCovered(const QGV::GeoTilePos& tilePos);
     void removeForPerfomance(const QGV::GeoTilePos& tilePos);
     void addTile(const QGV::GeoTilePos& tilePos, QGVDrawItem* tileObj);
+    void requestOverzoomSource(const QGV::GeoTilePos& tilePos);
+    void onOverzoomSource(const QGV::GeoTilePos& source, QGVDrawItem* tileObj);
+    void removeInactiveOverzoom();
     void removeTile(const QGV::GeoTilePos& tilePos);
+    void addPlaceholder(const QGV::GeoTilePos& tilePos);
+    void removePlaceholder(const QGV::GeoTilePos& tilePos);
+    void removeAllPlaceholders();
     bool isTileExists(const QGV::GeoTilePos& tilePos) const;
+    bool isTileActive(const QGV::GeoTilePos& tilePos) const;
     bool isTileFinished(const QGV::GeoTilePos& tilePos) const;
     QList<QGV::GeoTilePos> existingTiles(int zoom) const;
+    QList<QGV::GeoTilePos> existingTiles(int zoom, const QGV::GeoTilePos& root) const;
 
 private:
     int mCurZoom;
-    QRect mCurRect;
-    QMap<int, QMap<QGV::GeoTilePos, QGVDrawItem*>> mIndex;
+    QList<QRect> mCurRects;
+    int mTilePixelSize;
+    QGVTileGrid mTileGrid;
+    QMap<int, QMap<QGV::GeoTileId, QGVDrawItem*>> mIndex;
+    QMap<QGV::GeoTilePos, QGVDrawItem*> mPlaceholders;
+    QCache<QGV::GeoTilePos, QImage> mDecoded;
+    QSet<QGV::GeoTilePos> mPrefetchPlan;
+    QSet<QGV::GeoTilePos> mOverzoomWaiting;
+    QSet<QGV::GeoTilePos> mOverzoomSources;
 
     QElapsedTimer mLastAnimation;
+    QElapsedTimer mLastMove;
+    QPointF mVelocity;
 
     struct
     {
@@ -75,5 +132,12 @@ private:
         bool CameraUpdatesDuringAnimation = true;
         size_t VisibleZoomLayersBelowCurrent = 10;
         size_t VisibleZoomLayersAboveCurrent = 10;
+        bool PrefetchTrajectory = false;
+        bool PrefetchVelocity = false;
+        size_t PrefetchLookaheadMs = 500;
+        size_t PrefetchMaxTiles = 256;
+        bool ParentPlaceholders = false;
+        size_t OverzoomLevels = 0;
+        bool OpaqueTiles = false;
     } mPerfomanceProfile;
 };
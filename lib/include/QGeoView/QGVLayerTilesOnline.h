@@ -21,12 +21,22 @@
 #include "QGVLayerTiles.h"
 #include "QGVLayerTilesOnlineCache.h"
 
+#include <QCache>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QIODevice>
 #include <QFile>
 #include <QImage>
 #include <QPen>
 #include <QPainter>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+
+class QGVLayerTilesOnlineWorker;
+class QThread;
 
 class QGV_LIB_DECL QGVLayerTilesOnline : public QGVLayerTiles
 {
@@ -37,22 +47,121 @@ public:
     ~QGVLayerTilesOnline();
     void setCache(bool mode);
     void setOffline(bool mode);
+    void setMirrorsEnabled(bool enabled);
+    void setHedgePercentile(double percentile);
+    void setMaxRetries(int value);
+    void setAutoOffline(bool enabled);
+    bool isOfflineActive() const;
+    void setNetworkManager(QNetworkAccessManager* manager);
+    void setDedicatedNetworkManager(bool enabled);
+    QNetworkAccessManager* getNetworkManager() const;
+    void setHttp2(bool enabled);
+    void setConnectionsPerHost(int value);
+    void setKeepAliveTimeout(int seconds);
+    void setUserAgent(const QByteArray& userAgent);
+    void setNetworkThread(bool enabled);
+    bool isNetworkThread() const;
     int loadTilesFromGeo(QGV::GeoRect areaGeoRect, int zoom);
+    int countRequestsInFlight() const override;
+
+    // used by download jobs
+    QNetworkReply* downloadTile(const QGV::GeoTilePos& tilePos);
+    QSet<QGV::GeoTileId> cachedTileIds(const QGV::GeoTilePos& root, int zoom);
+    void storeTiles(const QList<QPair<QGV::GeoTilePos, QByteArray>>& tiles);
+
+Q_SIGNALS:
+    void offlineChanged(bool offline);
 
 protected:
     virtual QString tilePosToUrl(const QGV::GeoTilePos& tilePos) const = 0;
+    virtual int mirrorsCount() const;
+    virtual QString tilePosToMirrorUrl(const QGV::GeoTilePos& tilePos, int mirror) const;
 
 private:
     void request(const QGV::GeoTilePos& tilePos) override;
     void cancel(const QGV::GeoTilePos& tilePos) override;
+    void prefetch(const QGV::GeoTilePos& tilePos) override;
+    void abortPrefetch(const QSet<QGV::GeoTilePos>& keep) override;
+    QImage decodedTile(const QGV::GeoTilePos& tilePos) override;
+    void switchNetworkManager(QNetworkAccessManager* manager, bool dedicated);
+    QNetworkReply* sendRequest(const QUrl& url, QNetworkRequest::Priority priority);
+    QNetworkRequest makeRequest(const QUrl& url, QNetworkRequest::Priority priority) const;
     void onReplyFinished(QNetworkReply* reply, const QGV::GeoTilePos& tilePos);
+    void onPrefetchFinished(QNetworkReply* reply, const QGV::GeoTilePos& tilePos);
     void removeReply(const QGV::GeoTilePos& tilePos);
-    void incOfflineCnt();
+    void onRequestFailed(const QGV::GeoTilePos& tilePos, int status, const QString& error);
+    void retryRequest(const QGV::GeoTilePos& tilePos, int attempt);
+    bool isTileMissing(const QGV::GeoTilePos& tilePos);
+    void showMissingTile(const QGV::GeoTilePos& tilePos);
+    void showOfflineTile(const QGV::GeoTilePos& tilePos);
+    void markTileMissing(const QGV::GeoTilePos& tilePos);
+    void deferTile(const QGV::GeoTilePos& tilePos);
+    bool isProbeDue() const;
+    void consumeProbe();
+    void updateProbeTimer();
+    void onProbeTimer();
+    void onProbeFinished(QNetworkReply* reply);
+    void incOfflineCnt(const QGV::GeoTilePos& tilePos);
+    void decOfflineCnt();
+    void addOfflineSample(bool failed);
+    void clearOfflineCnt();
+    void requestDeferred();
+    void setAutoOfflineState(bool offline);
+    QNetworkReply* sendTileRequest(const QGV::GeoTilePos& tilePos, QNetworkRequest::Priority priority, int excludeMirror = -1);
+    int selectMirror(int excludeMirror);
+    void onMirrorFinished(QNetworkReply* reply);
+    void updateMirrorHealth(int mirror, bool failed, qint64 latency);
+    qint64 hedgeDelayMs() const;
+    void scheduleHedge(const QGV::GeoTilePos& tilePos, QNetworkReply* reply);
+    void hedgeRequest(const QGV::GeoTilePos& tilePos, QNetworkReply* reply);
+    void sendWorkerTask(const QGV::GeoTilePos& tilePos, QNetworkRequest::Priority priority, bool decode);
+    void onWorkerLoaded(const QGV::GeoTilePos& tilePos, const QImage& image, const QString& source, bool decoded);
+    void onWorkerMissed(const QGV::GeoTilePos& tilePos, bool decoded);
+    void onWorkerFailed(const QGV::GeoTilePos& tilePos, int status, const QString& error, bool decoded);
+    void updateWorkerNetwork();
+    void stopWorker();
 private:
+    struct MirrorHealth
+    {
+        QVector<qint64> latencyMs;
+        int latencyPos = 0;
+        double errorRate = 0.0;
+        int skipped = 0;
+    };
+
     QMap<QGV::GeoTilePos, QNetworkReply*> mRequest;
+    QMap<QGV::GeoTilePos, QNetworkReply*> mHedge;
+    QMap<QGV::GeoTilePos, QNetworkReply*> mPrefetch;
+    QCache<QGV::GeoTilePos, QByteArray> mPrefetched;
     QGVLayerTilesOnlineCache mCache;
+    QHash<QGV::GeoTilePos, int> mAttempts;
+    QCache<QGV::GeoTilePos, qint64> mMissing;
+    QSet<QGV::GeoTilePos> mDeferred;
+    int mMaxRetries = 3;
+    QVector<bool> mOfflineWindow;
+    int mOfflineWindowPos = 0;
     int offline_counter = 0;
-    int offline_cnt_max = 50;
+    int offline_cnt_max = 20;
+    bool mProbeDue = false;
+    QGV::GeoTilePos mProbeTile;
+    QTimer mProbeTimer;
     bool isOffline = false;
+    bool mAutoOfflineEnabled = true;
+    bool mAutoOfflineActive = false;
     bool isCache = true;
+    QVector<MirrorHealth> mMirrors;
+    int mNextMirror = 0;
+    bool mMirrorsEnabled = false;
+    double mHedgePercentile = 0.0;
+    QElapsedTimer mClock;
+    QPointer<QNetworkAccessManager> mNetworkManager;
+    bool mDedicatedNetworkManager = false;
+    bool mHttp2 = true;
+    int mConnectionsPerHost = 0;
+    int mKeepAliveTimeout = 0;
+    QByteArray mUserAgent;
+    QThread* mWorkerThread = nullptr;
+    QGVLayerTilesOnlineWorker* mWorker = nullptr;
+    QSet<QGV::GeoTilePos> mWorkerRequest;
+    QSet<QGV::GeoTilePos> mWorkerPrefetch;
 };
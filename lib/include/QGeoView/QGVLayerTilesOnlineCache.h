@@ -28,14 +28,19 @@
 #include <QPen>
 #include <QPainter>
 #include <QDir>
+#include <QSet>
 
 #define cache_dir     "cache/"
 #define cache_db      "cache.db"
 #define d_width       256
 #define d_height      256
-#define cache_insert  "insert into tiles_cache (t_scheme,t_x,t_y,t_zoom,t_name,t_datetime,t_datetime_u,t_size) values('%1',%2,%3,%4,'%5',datetime(),strftime('%s', 'now'),%6);"
-#define cache_sel     "select t_x,t_y,t_zoom,t_name,t_datetime,t_datetime_u from tiles_cache where t_scheme = '%1' and t_x = %2 and t_y = %3 and t_zoom = %4;"
-#define cache_create  "CREATE TABLE IF NOT EXISTS tiles_cache(t_scheme text NOT NULL,	t_x integer NOT NULL, t_y integer NOT NULL,	t_zoom integer NOT NULL, t_name text, t_datetime text NOT NULL,	t_datetime_u integer NOT NULL, t_type text,	t_size int, PRIMARY KEY(t_scheme, t_x, t_y, t_zoom));"
+#define cache_insert  "insert or replace into tiles (t_scheme,t_id,t_x,t_y,t_zoom,t_name,t_datetime,t_datetime_u,t_size) values('%1',%2,%3,%4,%5,'%6',datetime(),strftime('%s', 'now'),%7);"
+#define cache_sel     "select t_x,t_y,t_zoom,t_name,t_datetime,t_datetime_u from tiles where t_scheme = '%1' and t_id = %2;"
+#define cache_sel_ids "select t_id from tiles where t_scheme = '%1' and t_zoom = %2 and t_id >= %3 and t_id < %4;"
+#define cache_create  "CREATE TABLE IF NOT EXISTS tiles(t_scheme text NOT NULL, t_id integer NOT NULL, t_x integer NOT NULL, t_y integer NOT NULL, t_zoom integer NOT NULL, t_name text, t_datetime text NOT NULL, t_datetime_u integer NOT NULL, t_type text, t_size int, PRIMARY KEY(t_scheme, t_id)) WITHOUT ROWID;"
+#define cache_old     "select t_scheme,t_x,t_y,t_zoom,t_name,t_datetime,t_datetime_u,t_type,t_size from tiles_cache;"
+#define cache_migrate "insert or replace into tiles (t_scheme,t_id,t_x,t_y,t_zoom,t_name,t_datetime,t_datetime_u,t_type,t_size) values(?,?,?,?,?,?,?,?,?,?);"
+#define cache_drop_old "DROP TABLE tiles_cache;"
 #define db_col_name   3
 
 class QGV_LIB_DECL QGVLayerTilesOnlineCache
@@ -43,9 +48,13 @@ class QGV_LIB_DECL QGVLayerTilesOnlineCache
 public:
     ~QGVLayerTilesOnlineCache();
     void init_cache();
+    bool hasTileInCache(QString tile_name);
     QByteArray getTileFromCache(const QGV::GeoTilePos& tilePos, QString tile_name, QString prv_name);
     QImage getNoData(QString _text);
-    bool putTileToCache(const QGV::GeoTilePos& tilePos, QString tile_name, QString prv_name, QByteArray raw_tile);
+    bool putTileToCache(const QGV::GeoTilePos& tilePos, QString tile_name, QString prv_name, const QByteArray& raw_tile);
+    void beginTransaction();
+    void commitTransaction();
+    QSet<QGV::GeoTileId> cachedTileIds(const QGV::GeoTilePos& root, int zoom, QString prv_name);
 
 protected:
     
@@ -54,9 +63,12 @@ private:
     QString parseUrl2fileName(QString url);
     int insertTile2Db(const QGV::GeoTilePos& tilePos, QString tile_fname, QString prv_name, int fsize);
     bool createCache2Db();
+    void migrateCache2Db();
+    bool execSql(const char* sql);
     QString getTileFromDb(const QGV::GeoTilePos& tilePos, QString prv_name);
 
     sqlite3 *mDb;
     int mret;
     int cache_time = 3600;
+    int transaction_depth = 0;
 };
@@ -0,0 +1,100 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGVLayerTilesOnline.h"
+
+#include <QHash>
+#include <QPointer>
+#include <QSet>
+
+/*!
+ * Job which downloads tiles of area to cache of online layer, zoom levels are processed one by one.
+ * Stopped job continues from the same position when it is started again. Position is kept in memory only,
+ * so after restart of application new job walks area from the beginning, but tiles which are already in cache
+ * are skipped without requests.
+ */
+class QGV_LIB_DECL QGVLayerTilesOnlineDownload : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QGVLayerTilesOnlineDownload(QGVLayerTilesOnline* layer, QObject* parent = nullptr);
+    ~QGVLayerTilesOnlineDownload();
+
+    void setArea(const QGV::GeoRect& areaGeoRect, int fromZoom, int toZoom);
+    void setMaxParallel(int value);
+    void setMaxRetries(int value);
+    void setBatchSize(int value);
+    void setAverageTileBytes(qint64 value);
+
+    qint64 estimateTiles() const;
+    qint64 estimateBytes() const;
+    qint64 processedTiles() const;
+    qint64 failedTiles() const;
+    bool isRunning() const;
+
+    void start();
+    void stop();
+
+Q_SIGNALS:
+    void progress(qint64 processed, qint64 total);
+    void finished();
+
+private:
+    struct Task
+    {
+        QGV::GeoTilePos tilePos;
+        int attempts;
+    };
+
+    QList<QRect> zoomRects(int zoom) const;
+    QSet<QGV::GeoTileId> cachedIds(int zoom) const;
+    bool nextTile(QGV::GeoTilePos& tilePos);
+    void fill();
+    void download(const Task& task);
+    void onReplyFinished(QNetworkReply* reply);
+    void onTileDone();
+    void onOfflineChanged(bool offline);
+    void commitBatch();
+
+private:
+    QPointer<QGVLayerTilesOnline> mLayer;
+    QGV::GeoRect mArea;
+    QVector<QGV::GeoRect> mAreaParts;
+    int mFromZoom;
+    int mToZoom;
+    int mMaxParallel;
+    int mMaxRetries;
+    int mBatchSize;
+    qint64 mAverageTileBytes;
+    bool mRunning;
+    int mCurZoom;
+    qint64 mCurIndex;
+    QList<Task> mRetry;
+    QHash<QNetworkReply*, Task> mActive;
+    int mScheduledRetries;
+    int mCachedZoom;
+    QSet<QGV::GeoTileId> mCachedIds;
+    QList<QPair<QGV::GeoTilePos, QByteArray>> mBatch;
+    qint64 mProcessed;
+    qint64 mFailed;
+    qint64 mDownloaded;
+    qint64 mDownloadedBytes;
+};
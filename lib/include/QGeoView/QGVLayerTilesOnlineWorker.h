@@ -0,0 +1,82 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGVLayerTilesOnlineCache.h"
+
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkProxy>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QScopedPointer>
+
+/*!
+ * Fetch-and-cache pipeline of online layer which runs in its own thread.
+ * Worker reads and writes tile cache, downloads and decodes tiles, so only ready-to-display images
+ * are passed to GUI thread.
+ */
+class QGV_LIB_DECL QGVLayerTilesOnlineWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Task
+    {
+        QGV::GeoTilePos tilePos;
+        QNetworkRequest request;
+        QString tileName;
+        QString provider;
+        int mirror = 0;
+        bool cache = true;
+        bool network = true;
+        bool decode = true;
+        bool opaque = false;
+        qint64 queuedUs = 0;
+    };
+
+    explicit QGVLayerTilesOnlineWorker(QObject* parent = nullptr);
+    ~QGVLayerTilesOnlineWorker();
+
+    void setNetworkSettings(const QNetworkProxy& proxy, const QString& cacheDirectory, qint64 cacheSize);
+    void fetch(const Task& task);
+    void cancel(const QGV::GeoTilePos& tilePos);
+
+Q_SIGNALS:
+    // decoded is false for result of prefetch, which only puts tile to cache
+    void tileLoaded(const QGV::GeoTilePos& tilePos, const QImage& image, const QString& source, bool decoded);
+    void tileMissed(const QGV::GeoTilePos& tilePos, bool decoded);
+    void tileFailed(const QGV::GeoTilePos& tilePos, int status, const QString& error, bool decoded);
+    void mirrorFinished(int mirror, bool failed, qint64 latencyMs);
+
+private:
+    QGVLayerTilesOnlineCache* cache();
+    void applyNetworkSettings();
+    void onReplyFinished(QNetworkReply* reply, const QGV::GeoTilePos& tilePos, qint64 started);
+    void finishTile(const Task& task, const QByteArray& rawImage, const QString& source);
+
+private:
+    QNetworkAccessManager* mManager;
+    QNetworkProxy mProxy;
+    QString mCacheDirectory;
+    qint64 mCacheSize;
+    QScopedPointer<QGVLayerTilesOnlineCache> mCache;
+    QHash<QGV::GeoTilePos, Task> mTasks;
+    QHash<QGV::GeoTilePos, QNetworkReply*> mReplies;
+};
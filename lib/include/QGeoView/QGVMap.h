@@ -25,6 +25,7 @@
 #include "QGVGlobal.h"
 #include "QGVProjection.h"
 
+class QThreadPool;
 class QGVItem;
 class QGVDrawItem;
 class QGVWidget;
@@ -47,6 +48,13 @@ public:
     void setProjection(QGVProjection* projection);
     QGVProjection* getProjection() const;
 
+    void setWorldCopies(bool enabled);
+    bool isWorldCopies() const;
+    bool isWorldWrap() const;
+    QList<double> worldOffsets(const QRectF& projRect) const;
+    QPointF foldProjPos(const QPointF& projPos) const;
+    QList<QRectF> foldProjRect(const QRectF& projRect) const;
+
     void setMouseActions(QGV::MouseActions actions);
     void setMouseAction(QGV::MouseAction action, bool enabled = true);
     QGV::MouseActions getMouseActions() const;
@@ -87,6 +95,7 @@ public:
 
     virtual void onMapState(QGV::MapState state);
     virtual void onMapCamera(const QGVCameraState& oldState, const QGVCameraState& newState);
+    virtual void onMapTrajectory(const QList<QGVCameraState>& states);
 
 protected:
     void mouseMoveEvent(QMouseEvent* event) override;
@@ -113,5 +122,8 @@ private:
     QScopedPointer<QGVItem> mRootItem;
     QList<QGVWidget*> mWidgets;
     QSet<QGVItem*> mSelections;
+    bool mWorldCopies;
+    QScopedPointer<QThreadPool> mPreparePool;
     void handleDropDataOnQGVMapQGView(QPointF position, const QMimeData* dropData);
+    void prepareProjection(const QList<QGVItem*>& items);
 };
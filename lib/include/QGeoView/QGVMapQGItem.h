@@ -21,6 +21,7 @@
 #include "QGVGlobal.h"
 
 #include <QGraphicsItem>
+#include <QPainterPath>
 
 class QGVDrawItem;
 
@@ -32,6 +33,8 @@ public:
     static QGVDrawItem* geoObjectFromQGItem(QGraphicsItem* item);
 
     void resetGeometry();
+    int getPaintCount() const;
+    int getShapeCount() const;
 
 private:
     QRectF boundingRect() const override final;
@@ -42,4 +45,9 @@ private:
 
 private:
     QGVDrawItem* mGeoObject;
+    int mPaintCount;
+    mutable int mShapeCount;
+    QString mDebugText;
+    QRect mDebugRect;
+    QPainterPath mDebugPath;
 };
@@ -28,10 +28,28 @@
 #include <QDragMoveEvent>
 #include <QDropEvent>
 #include <QGraphicsView>
+#include <QHash>
 #include <QMenu>
 #include <QMimeData>
+#include <QPixmap>
+#include <QSet>
 
 class QGVMap;
+class QGVItem;
+
+/*!
+ * Paint time of frames and of top level items (layers) collected by QGVMapQGView.
+ * Items cached by QGraphicsItem::DeviceCoordinateCache are painted only when their cache is invalid.
+ */
+struct QGVPaintStats
+{
+    qint64 frames = 0;
+    qint64 lastFrameUs = 0;
+    qint64 totalFrameUs = 0;
+    qint64 maxFrameUs = 0;
+    QHash<const QGVItem*, qint64> layerPaintUs;
+    QHash<const QGVItem*, qint64> layerPaintCount;
+};
 
 class QGV_LIB_DECL QGVMapQGView : public QGraphicsView
 {
@@ -50,6 +68,13 @@ public:
     void setScaleLimits(double minScale, double maxScale);
     void cleanState();
 
+    void setPaintProfiling(bool enabled);
+    bool isPaintProfiling() const;
+    void addPaintTime(const QGVItem* item, qint64 paintUs);
+    const QGVPaintStats& getPaintStats() const;
+    void resetPaintStats();
+    void updateWorldCopies();
+
 Q_SIGNALS:
     void dropData(QPointF position, const QMimeData* dropData);
 
@@ -60,6 +85,8 @@ private:
     void cameraScale(const QRectF& projRect);
     void cameraRotate(double azimuth);
     void cameraMove(const QPointF& projPos);
+    void onSceneChanged(const QList<QRectF>& region);
+    void drawWorldCopies();
     void blockCameraUpdate();
     void unblockCameraUpdate();
     void applyCameraUpdate(const QGVCameraState& oldState);
@@ -95,6 +122,8 @@ private:
     void dragMoveEvent(QDragMoveEvent* event) override final;
     void dropEvent(QDropEvent* event) override final;
     void dragLeaveEvent(QDragLeaveEvent* event) override final;
+    void drawForeground(QPainter* painter, const QRectF& rect) override final;
+    void paintEvent(QPaintEvent* event) override final;
 
 private:
     QGVMap* mGeoMap;
@@ -114,4 +143,10 @@ private:
     QScopedPointer<QGraphicsScene> mQGScene;
     QScopedPointer<QGVMapRubberBand> mSelectionRect;
     QScopedPointer<QMenu> mContextMenu;
+    bool mPaintProfiling;
+    QGVPaintStats mPaintStats;
+    QSet<const QGVItem*> mPaintItems;
+    QPixmap mCopiesCache;
+    QRegion mCopiesDirty;
+    QMetaObject::Connection mCopiesConnection;
 };
@@ -0,0 +1,132 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <QGeoView/QGVGlobal.h>
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QVector>
+
+#include <atomic>
+
+/*!
+ * Metrics of tile pipeline: event counters, latency histograms of pipeline stages and optional
+ * Chrome trace events (chrome://tracing, Perfetto).
+ * Collection is disabled by default and then costs one atomic load per call. Metrics can be
+ * recorded and read from any thread.
+ */
+class QGV_LIB_DECL QGVMetrics
+{
+public:
+    enum class Counter
+    {
+        TilesRequested,
+        TilesFromMemory,
+        TilesFromDisk,
+        TilesFromNetwork,
+        TilesCanceled,
+        TilesFailed,
+    };
+    static const int CounterCount = 6;
+
+    enum class Stage
+    {
+        Queue,
+        Network,
+        Decode,
+        AddToScene,
+    };
+    static const int StageCount = 4;
+    static const int HistogramBuckets = 32;
+
+    struct Histogram
+    {
+        QVector<qint64> buckets;
+        qint64 count = 0;
+        qint64 totalUs = 0;
+        qint64 maxUs = 0;
+
+        static qint64 bucketUpperUs(int bucket);
+        double averageUs() const;
+        qint64 percentileUs(double percentile) const;
+    };
+
+    class QGV_LIB_DECL Scope
+    {
+    public:
+        explicit Scope(Stage stage);
+        ~Scope();
+
+    private:
+        Q_DISABLE_COPY(Scope)
+
+        Stage mStage;
+        qint64 mStartUs;
+    };
+
+    static QGVMetrics* instance();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    void setTraceEnabled(bool enabled);
+    bool isTraceEnabled() const;
+    void reset();
+
+    void add(Counter counter, qint64 value = 1);
+    void record(Stage stage, qint64 startUs, qint64 durationUs);
+    qint64 nowUs() const;
+
+    qint64 counter(Counter counter) const;
+    Histogram histogram(Stage stage) const;
+    QByteArray traceJson() const;
+    bool saveTrace(const QString& fileName) const;
+
+    static const char* counterName(Counter counter);
+    static const char* stageName(Stage stage);
+
+private:
+    QGVMetrics();
+    Q_DISABLE_COPY(QGVMetrics)
+
+    struct StageData
+    {
+        std::atomic<qint64> buckets[HistogramBuckets];
+        std::atomic<qint64> count;
+        std::atomic<qint64> totalUs;
+        std::atomic<qint64> maxUs;
+    };
+
+    struct TraceEvent
+    {
+        Stage stage;
+        qint64 startUs;
+        qint64 durationUs;
+        quint64 thread;
+    };
+
+private:
+    std::atomic<bool> mEnabled;
+    std::atomic<bool> mTraceEnabled;
+    QElapsedTimer mClock;
+    std::atomic<qint64> mCounters[CounterCount];
+    StageData mStages[StageCount];
+    mutable QMutex mTraceLock;
+    QVector<TraceEvent> mTrace;
+};
@@ -33,12 +33,23 @@ public:
     virtual QGV::GeoRect boundaryGeoRect() const = 0;
     virtual QRectF boundaryProjRect() const = 0;
 
+    // Projection repeats horizontally with period of boundaryProjRect() width (world copies)
+    virtual bool isWrapAround() const;
+
     virtual QPointF geoToProj(QGV::GeoPos const& geoPos) const = 0;
     virtual QGV::GeoPos projToGeo(QPointF const& projPos) const = 0;
     virtual QRectF geoToProj(QGV::GeoRect const& geoRect) const = 0;
     virtual QGV::GeoRect projToGeo(QRectF const& projRect) const = 0;
     virtual double geodesicMeters(QPointF const& projPos1, QPointF const& projPos2) const = 0;
 
+    // Batch conversion of contiguous arrays, count elements each. Ranges are independent so large
+    // arrays can be split between threads by caller.
+    virtual void geoToProjArray(const double* lat, const double* lon, double* x, double* y, size_t count) const;
+    virtual void projToGeoArray(const double* x, const double* y, double* lat, double* lon, size_t count) const;
+
+protected:
+    static double haversineMeters(QGV::GeoPos const& geoPos1, QGV::GeoPos const& geoPos2, double radius);
+
 private:
     Q_DISABLE_COPY(QGVProjection)
     QString mID;
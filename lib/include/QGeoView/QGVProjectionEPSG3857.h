@@ -29,6 +29,7 @@ public:
 private:
     QGV::GeoRect boundaryGeoRect() const override final;
     QRectF boundaryProjRect() const override final;
+    bool isWrapAround() const override final;
 
     QPointF geoToProj(QGV::GeoPos const& geoPos) const override final;
     QGV::GeoPos projToGeo(QPointF const& projPos) const override final;
@@ -37,9 +38,14 @@ private:
 
     double geodesicMeters(QPointF const& projPos1, QPointF const& projPos2) const override final;
 
+    void geoToProjArray(const double* lat, const double* lon, double* x, double* y, size_t count) const override final;
+    void projToGeoArray(const double* x, const double* y, double* lat, double* lon, size_t count) const override final;
+
 private:
     double mEarthRadius;
     double mOriginShift;
+    double mMaxLatitude;
+    double mMinLatitude;
     QGV::GeoRect mGeoBoundary;
     QRectF mProjBoundary;
 };
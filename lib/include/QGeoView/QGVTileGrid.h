@@ -0,0 +1,52 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGVProjection.h"
+
+#include <QRect>
+#include <QSharedPointer>
+
+/*
+ * Tile grid defines how tiles of each zoom level cover area of projection. Every tile is a rectangle of equal size
+ * in coordinates of grid projection, zoom level 0 has given number of tiles and each next level splits tile by 4.
+ */
+class QGV_LIB_DECL QGVTileGrid
+{
+public:
+    QGVTileGrid(QSharedPointer<const QGVProjection> projection, const QRectF& projExtent, const QSize& zeroZoomTiles);
+
+    static QGVTileGrid mercator();
+    static QGVTileGrid geographic();
+
+    QSharedPointer<const QGVProjection> getProjection() const;
+    QRectF getProjExtent() const;
+    QSize tilesCount(int zoom) const;
+    int zoomOffset() const;
+
+    QGV::GeoTilePos geoToTilePos(int zoom, const QGV::GeoPos& geoPos) const;
+    QRect tilesRect(int zoom, const QGV::GeoRect& geoRect) const;
+    QGV::GeoRect toGeoRect(const QGV::GeoTilePos& tilePos) const;
+
+private:
+    QSharedPointer<const QGVProjection> mProjection;
+    QRectF mProjExtent;
+    QSize mZeroZoomTiles;
+    int mZoomOffset;
+};
@@ -0,0 +1,69 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGVGlobal.h"
+
+#include <QStringList>
+#include <QVector>
+
+/*!
+ * Tile url template which is parsed once and then expanded for each tile in a single pass.
+ * Supported placeholders: ${z}, ${x}, ${y}, ${qk} (quad key) and ${name} for each of given variables.
+ * Placeholders are case insensitive, other text is kept as is.
+ */
+class QGV_LIB_DECL QGVUrlTemplate
+{
+public:
+    QGVUrlTemplate();
+    explicit QGVUrlTemplate(const QString& url, const QStringList& variables = QStringList());
+
+    bool isEmpty() const;
+    QString getUrl() const;
+
+    void bind(const QString& variable, const QString& value);
+
+    QString toUrl(const QGV::GeoTilePos& tilePos, const QStringList& values = QStringList()) const;
+
+private:
+    enum class Field
+    {
+        Text,
+        Zoom,
+        X,
+        Y,
+        QuadKey,
+        Variable,
+    };
+
+    struct Segment
+    {
+        Field field;
+        QString text;
+        int index;
+    };
+
+    void append(const Segment& segment);
+
+private:
+    QString mUrl;
+    QStringList mVariables;
+    QVector<Segment> mSegments;
+    int mReserve;
+};
@@ -0,0 +1,65 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include "QGVWidget.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QLabel>
+#include <QTimer>
+
+/*!
+ * Performance overlay: paint time per frame, scene items, visible items and paint time per layer,
+ * pending tiles and estimated pixmap cache memory.
+ * Paint profiling of map is switched on while widget is visible.
+ */
+class QGV_LIB_DECL QGVWidgetProfiler : public QGVWidget
+{
+    Q_OBJECT
+
+public:
+    QGVWidgetProfiler();
+    ~QGVWidgetProfiler();
+
+    void setUpdateInterval(int msec);
+    int getUpdateInterval() const;
+
+    QString paintReport() const;
+    void dumpPaintReport() const;
+    void resetStats();
+
+    QLabel* label();
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    void setProfiling(bool enabled);
+    void updateText();
+
+private:
+    QScopedPointer<QLabel> mLabel;
+    QTimer mTimer;
+    QElapsedTimer mInterval;
+    qint64 mLastFrames;
+    qint64 mLastFrameUs;
+    QHash<const QGVItem*, qint64> mLastLayerPaintUs;
+};
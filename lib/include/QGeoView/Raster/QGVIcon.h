@@ -30,11 +30,12 @@ public:
     void setGeometry(const QGV::GeoPos& geoPos, const QSizeF& imageSize = QSizeF());
     void setGeometry(const QPointF& projPos, const QSizeF& imageSize = QSizeF());
 
-    QImage getImage() const;
+    const QImage& getImage() const;
     bool isImage() const;
 
     void loadImage(const QByteArray& rawData);
     void loadImage(const QImage& image);
+    void loadIcon(const QString& key);
 
 protected:
     void onProjection(QGVMap* geoMap) override;
@@ -51,5 +52,7 @@ private:
     QRectF mProjRect;
 
     QString mUrl;
+    QString mIconKey;
     QImage mImage;
+    QImage mScaledImage;
 };
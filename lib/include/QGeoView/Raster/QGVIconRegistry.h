@@ -0,0 +1,60 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <QGeoView/QGVGlobal.h>
+
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QReadWriteLock>
+
+/*!
+ * Registry of decoded symbols shared by QGVIcon items.
+ * Each symbol is decoded once and the same image data is implicitly shared by all icons which use it. Variants
+ * scaled to pixel size of screen are cached on first use, least recently used ones are dropped when cache is full.
+ * Registry can be populated from any thread.
+ */
+class QGV_LIB_DECL QGVIconRegistry
+{
+public:
+    static QGVIconRegistry* instance();
+
+    QImage add(const QString& key, const QByteArray& rawData);
+    QImage add(const QString& key, const QImage& image);
+    void remove(const QString& key);
+    void clear();
+
+    bool contains(const QString& key) const;
+    QImage image(const QString& key) const;
+    QImage image(const QString& key, const QSize& size, double devicePixelRatio) const;
+
+private:
+    QGVIconRegistry();
+    Q_DISABLE_COPY(QGVIconRegistry)
+
+    static QString scaledKey(const QString& key, const QSize& pixelSize);
+
+private:
+    mutable QReadWriteLock mLock;
+    QHash<QString, QImage> mImages;
+    mutable QMutex mScaledLock;
+    mutable QCache<QString, QImage> mScaled;
+};
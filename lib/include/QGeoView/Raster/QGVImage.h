@@ -20,6 +20,9 @@
 
 #include <QGeoView/QGVDrawItem.h>
 
+#include <QIODevice>
+#include <QSharedPointer>
+
 class QGV_LIB_DECL QGVImage : public QGVDrawItem
 {
     Q_OBJECT
@@ -28,29 +31,48 @@ public:
     QGVImage();
 
     void setGeometry(const QGV::GeoRect& geoRect);
+    void setGeometry(const QGV::GeoRect& geoRect, QSharedPointer<const QGVProjection> imageProjection);
     void setGeometry(const QRectF& projRect);
 
-    QImage getImage() const;
+    const QImage& getImage() const;
     bool isImage() const;
 
     void loadImage(const QByteArray& rawData);
+    void loadImage(QIODevice* device, const QByteArray& format = QByteArray());
     void loadImage(const QImage& image);
 
     void setCeilingOnScale(bool enabled);
+    void setOpaque(bool opaque);
+    bool isOpaque() const;
+
+    static QImage toPaintFormat(const QImage& image, bool opaque = false);
 
 protected:
+    void onProjectionPrepare(const QGVProjection* projection) override;
+    int projectionCost() const override;
     void onProjection(QGVMap* geoMap) override;
     QPainterPath projShape() const override;
     void projPaint(QPainter* painter) override;
 
 private:
     void calculateGeometry();
+    void calculateProjection(const QGVProjection* projection);
+    void calculateMesh(const QGVProjection* projection);
 
 private:
+    struct MeshCell
+    {
+        QRectF imageRect;
+        QTransform transform;
+    };
+
     QGV::GeoRect mGeoRect;
     QRectF mProjRect;
+    QSharedPointer<const QGVProjection> mImageProjection;
+    QVector<MeshCell> mMesh;
 
     QString mUrl;
     QImage mImage;
     bool mCeilingOnScale;
+    bool mOpaque;
 };
@@ -5,6 +5,9 @@ QT += gui widgets network
 
 DEFINES += QGV_EXPORT
 
+# refresh and paint counters for debug output, enabled by CONFIG+=qgv_debug_counters
+qgv_debug_counters: DEFINES += QGV_DEBUG_COUNTERS
+
 HEADERS += \
     $$PWD/include/QGeoView/QGVCamera.h \
     $$PWD/include/QGeoView/QGVDrawItem.h \
@@ -24,14 +27,23 @@ HEADERS += \
     $$PWD/include/QGeoView/QGVMapRubberBand.h \
     $$PWD/include/QGeoView/QGVProjection.h \
     $$PWD/include/QGeoView/QGVProjectionEPSG3857.h \
+    $$PWD/include/QGeoView/QGVProjectionEPSG4326.h \
+    $$PWD/include/QGeoView/QGVProjectionUTM.h \
+    $$PWD/include/QGeoView/QGVTileGrid.h \
+    $$PWD/include/QGeoView/QGVUrlTemplate.h \
     $$PWD/include/QGeoView/QGVWidget.h \
     $$PWD/include/QGeoView/QGVWidgetCompass.h \
     $$PWD/include/QGeoView/QGVWidgetScale.h \
     $$PWD/include/QGeoView/QGVWidgetText.h \
+    $$PWD/include/QGeoView/QGVWidgetProfiler.h \
     $$PWD/include/QGeoView/QGVWidgetZoom.h \
     $$PWD/include/QGeoView/Raster/QGVImage.h \
     $$PWD/include/QGeoView/Raster/QGVIcon.h \
-    $$PWD/include/QGeoView/QGVLayerTilesOnlineCache.h
+    $$PWD/include/QGeoView/Raster/QGVIconRegistry.h \
+    $$PWD/include/QGeoView/QGVLayerTilesOnlineCache.h \
+    $$PWD/include/QGeoView/QGVLayerTilesOnlineDownload.h \
+    $$PWD/include/QGeoView/QGVLayerTilesOnlineWorker.h \
+    $$PWD/include/QGeoView/QGVMetrics.h
 
 SOURCES += \
     $$PWD/src/QGVCamera.cpp \
@@ -52,14 +64,23 @@ SOURCES += \
     $$PWD/src/QGVMapRubberBand.cpp \
     $$PWD/src/QGVProjection.cpp \
     $$PWD/src/QGVProjectionEPSG3857.cpp \
+    $$PWD/src/QGVProjectionEPSG4326.cpp \
+    $$PWD/src/QGVProjectionUTM.cpp \
+    $$PWD/src/QGVTileGrid.cpp \
+    $$PWD/src/QGVUrlTemplate.cpp \
     $$PWD/src/QGVWidget.cpp \
     $$PWD/src/QGVWidgetCompass.cpp \
     $$PWD/src/QGVWidgetScale.cpp \
     $$PWD/src/QGVWidgetText.cpp \
+    $$PWD/src/QGVWidgetProfiler.cpp \
     $$PWD/src/QGVWidgetZoom.cpp \
     $$PWD/src/Raster/QGVImage.cpp \
     $$PWD/src/Raster/QGVIcon.cpp \
-    $$PWD/src/QGVLayerTilesOnlineCache.cpp
+    $$PWD/src/Raster/QGVIconRegistry.cpp \
+    $$PWD/src/QGVLayerTilesOnlineCache.cpp \
+    $$PWD/src/QGVLayerTilesOnlineDownload.cpp \
+    $$PWD/src/QGVLayerTilesOnlineWorker.cpp \
+    $$PWD/src/QGVMetrics.cpp
 
 INCLUDEPATH += \
     $$PWD/include/ \
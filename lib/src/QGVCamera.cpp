@@ -21,6 +21,10 @@
 
 #include <QtMath>
 
+namespace {
+int trajectorySamples = 16;
+}
+
 QGVCameraState::QGVCameraState(QGVMap* geoMap, double azimuth, double scale, const QRectF& projRect, bool animation)
     : mGeoMap(geoMap)
     , mScale(scale)
@@ -234,6 +238,26 @@ QGVCameraActions& QGVCameraAnimation::actions()
     return mActions;
 }
 
+QList<QGVCameraState> QGVCameraAnimation::trajectory(int samples)
+{
+    QList<QGVCameraState> result;
+    const QGVCameraState& origin = mActions.origin();
+    const QSizeF originSize = origin.projRect().size() * origin.scale();
+    for (int i = 1; i <= samples; ++i) {
+        double progress = static_cast<double>(i) / samples;
+        if (direction() == Direction::Backward) {
+            progress = 1.0 - progress;
+        }
+        QGVCameraActions target(mActions);
+        target.reset();
+        onProgress(progress, target);
+        QRectF projRect(QPointF(0, 0), originSize / target.scale());
+        projRect.moveCenter(target.projCenter());
+        result.append(QGVCameraState(origin.getMap(), target.azimuth(), target.scale(), projRect, true));
+    }
+    return result;
+}
+
 void QGVCameraAnimation::onStart()
 {
 }
@@ -278,6 +302,7 @@ void QGVCameraAnimation::updateState(QAbstractAnimation::State newState, QAbstra
         mActions.rebase(geoMap->getCamera());
         connect(geoMap, &QGVMap::stateChanged, this, &QGVCameraAnimation::onStateChanged);
         onStart();
+        geoMap->onMapTrajectory(trajectory(trajectorySamples));
     }
     if (newState == QAbstractAnimation::Stopped && oldState != QAbstractAnimation::Stopped) {
         disconnect(geoMap, nullptr, this, nullptr);
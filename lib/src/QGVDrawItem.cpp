@@ -26,6 +26,7 @@ double highlightScale = 1.15;
 
 QGVDrawItem::QGVDrawItem()
     : mDirty{ false }
+    , mUpdateCount{ 0 }
 {
 }
 
@@ -99,9 +100,9 @@ void QGVDrawItem::refresh()
 
     mDirty = false;
 
-    if (QGV::isDrawDebug()) {
-        setProperty("updateCount", property("updateCount").toInt() + 1);
-    }
+#ifdef QGV_DEBUG_COUNTERS
+    mUpdateCount++;
+#endif
 }
 
 void QGVDrawItem::repaint()
@@ -137,6 +138,30 @@ QTransform QGVDrawItem::effectiveTransform() const
     return mQGDrawItem->transform();
 }
 
+/*!
+ * Refresh calls counter, available when library is built with QGV_DEBUG_COUNTERS.
+ */
+int QGVDrawItem::getUpdateCount() const
+{
+    return mUpdateCount;
+}
+
+/*!
+ * Paint calls counter, available when library is built with QGV_DEBUG_COUNTERS.
+ */
+int QGVDrawItem::getPaintCount() const
+{
+    return mQGDrawItem.isNull() ? 0 : mQGDrawItem->getPaintCount();
+}
+
+/*!
+ * Calls of projShape() made by scene, available when library is built with QGV_DEBUG_COUNTERS.
+ */
+int QGVDrawItem::getShapeCount() const
+{
+    return mQGDrawItem.isNull() ? 0 : mQGDrawItem->getShapeCount();
+}
+
 QPointF QGVDrawItem::projAnchor() const
 {
     return projShape().boundingRect().center();
@@ -154,11 +179,7 @@ QString QGVDrawItem::projTooltip(const QPointF& /*projPos*/) const
 
 QString QGVDrawItem::projDebug()
 {
-    return QString("%1\nupdate(%2,%3)")
-            .arg(property("drawDebug").toString())
-            .arg(property("updateCount").toInt())
-            .arg(property("paintCount").toInt())
-            .trimmed();
+    return property("drawDebug").toString();
 }
 
 void QGVDrawItem::projOnFlags()
@@ -19,14 +19,43 @@
 #include "QGVGlobal.h"
 #include "QGVMap.h"
 
+#include <QHash>
 #include <QTransform>
 #include <QtGlobal>
 #include <QtMath>
 
+#include <cmath>
+
 namespace {
 bool drawDebugEnabled = false;
 bool printDebugEnabled = false;
 QNetworkAccessManager* networkManager = nullptr;
+// one spare bit of Morton code is left for grids with two tiles at zero zoom level
+const int tileIdMaxZoom = 28;
+const int tileIdZoomBits = 5;
+const quint64 tileIdZoomMask = (1ull << tileIdZoomBits) - 1;
+
+quint64 spreadBits(quint32 value)
+{
+    quint64 bits = value;
+    bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFull;
+    bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FFull;
+    bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0Full;
+    bits = (bits | (bits << 2)) & 0x3333333333333333ull;
+    bits = (bits | (bits << 1)) & 0x5555555555555555ull;
+    return bits;
+}
+
+quint32 compactBits(quint64 value)
+{
+    quint64 bits = value & 0x5555555555555555ull;
+    bits = (bits | (bits >> 1)) & 0x3333333333333333ull;
+    bits = (bits | (bits >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+    bits = (bits | (bits >> 4)) & 0x00FF00FF00FF00FFull;
+    bits = (bits | (bits >> 8)) & 0x0000FFFF0000FFFFull;
+    bits = (bits | (bits >> 16)) & 0x00000000FFFFFFFFull;
+    return static_cast<quint32>(bits);
+}
 }
 
 namespace QGV {
@@ -229,11 +258,98 @@ bool GeoRect::contains(GeoRect const& rect) const
             rect.latTop() <= latTop());
 }
 
+/*!
+ * Rects are intersected when both their longitude and latitude intervals overlap.
+ * Touching rects are treated as intersected.
+ */
 bool GeoRect::intersects(const GeoRect& rect) const
 {
-    return contains(rect.topLeft()) || contains(rect.topRight()) || contains(rect.bottomLeft()) ||
-           contains(rect.bottomRight()) || rect.contains(topLeft()) || rect.contains(topRight()) ||
-           rect.contains(bottomLeft()) || rect.contains(bottomRight());
+    // non short-circuit operators are used intentionally to avoid branches
+    return (lonLeft() <= rect.lonRigth()) & (rect.lonLeft() <= lonRigth()) & (latBottom() <= rect.latTop()) &
+           (rect.latBottom() <= latTop());
+}
+
+/*!
+ * Same as contains(), but longitude of position is taken modulo 360 degrees.
+ * Can be used for rects which are partially out of range [-180, 180].
+ */
+bool GeoRect::containsWrapped(GeoPos const& pos) const
+{
+    const double lon = lonLeft() + std::fmod(std::fmod(pos.longitude() - lonLeft(), 360.0) + 360.0, 360.0);
+    return contains(GeoPos(pos.latitude(), lon));
+}
+
+/*!
+ * Same as intersects(), but longitudes are taken modulo 360 degrees.
+ * Can be used for rects which are partially out of range [-180, 180].
+ */
+bool GeoRect::intersectsWrapped(GeoRect const& rect) const
+{
+    if (lonRigth() - lonLeft() >= 360.0 || rect.lonRigth() - rect.lonLeft() >= 360.0) {
+        return (latBottom() <= rect.latTop()) && (rect.latBottom() <= latTop());
+    }
+    const double shift = 360.0 * std::floor((lonLeft() - rect.lonLeft()) / 360.0);
+    for (double offset : { shift, shift + 360.0 }) {
+        const GeoRect shifted(rect.latTop(), rect.lonLeft() + offset, rect.latBottom(), rect.lonRigth() + offset);
+        if (intersects(shifted)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * Rect from western to eastern longitude.
+ * Rect which crosses antimeridian (lonWest > lonEast) is split into two rects.
+ */
+QVector<GeoRect> GeoRect::fromWestEast(double lat1, double lonWest, double lat2, double lonEast)
+{
+    if (lonWest <= lonEast) {
+        return { GeoRect(lat1, lonWest, lat2, lonEast) };
+    }
+    return { GeoRect(lat1, lonWest, lat2, 180.0), GeoRect(lat1, -180.0, lat2, lonEast) };
+}
+
+/*!
+ * Indexes of rects which contain position.
+ */
+QVector<int> GeoRect::filterContains(const QVector<GeoRect>& rects, GeoPos const& pos)
+{
+    const double lat = pos.latitude();
+    const double lon = pos.longitude();
+    QVector<int> result;
+    result.reserve(rects.size());
+    for (int i = 0; i < rects.size(); i++) {
+        const GeoRect& rect = rects[i];
+        const bool inside = (rect.mTopLeft.longitude() <= lon) & (lon < rect.mBottomRight.longitude()) &
+                            (rect.mBottomRight.latitude() < lat) & (lat <= rect.mTopLeft.latitude());
+        if (inside) {
+            result.append(i);
+        }
+    }
+    return result;
+}
+
+/*!
+ * Indexes of rects which intersect given rect.
+ */
+QVector<int> GeoRect::filterIntersects(const QVector<GeoRect>& rects, GeoRect const& rect)
+{
+    const double left = rect.lonLeft();
+    const double right = rect.lonRigth();
+    const double bottom = rect.latBottom();
+    const double top = rect.latTop();
+    QVector<int> result;
+    result.reserve(rects.size());
+    for (int i = 0; i < rects.size(); i++) {
+        const GeoRect& other = rects[i];
+        const bool overlap = (other.mTopLeft.longitude() <= right) & (left <= other.mBottomRight.longitude()) &
+                             (other.mBottomRight.latitude() <= top) & (bottom <= other.mTopLeft.latitude());
+        if (overlap) {
+            result.append(i);
+        }
+    }
+    return result;
 }
 
 GeoTilePos::GeoTilePos()
@@ -290,6 +406,11 @@ bool GeoTilePos::operator<(const GeoTilePos& other) const
     return mPos.y() < other.mPos.y();
 }
 
+bool GeoTilePos::operator==(const GeoTilePos& other) const
+{
+    return mZoom == other.mZoom && mPos == other.mPos;
+}
+
 int GeoTilePos::zoom() const
 {
     return mZoom;
@@ -302,23 +423,30 @@ QPoint GeoTilePos::pos() const
 
 bool GeoTilePos::contains(const GeoTilePos& other) const
 {
-    if (zoom() >= other.zoom()) {
+    if (mZoom >= other.mZoom) {
         return false;
     }
-    GeoTilePos parentTile = other.parent(zoom());
-    return (pos().x() == parentTile.pos().x() && pos().y() == parentTile.pos().y());
+    const int deltaZoom = other.mZoom - mZoom;
+    return (other.mPos.x() >> deltaZoom) == mPos.x() && (other.mPos.y() >> deltaZoom) == mPos.y();
 }
 
 GeoTilePos GeoTilePos::parent(int parentZoom) const
 {
-    if (parentZoom >= zoom()) {
+    if (parentZoom >= mZoom) {
         return GeoTilePos();
     }
-    const int deltaZoom = zoom() - parentZoom;
-    const int factor = static_cast<int>(qPow(2, deltaZoom));
-    const int x = static_cast<int>(qFloor(pos().x() / factor));
-    const int y = static_cast<int>(qFloor(pos().y() / factor));
-    return GeoTilePos(parentZoom, QPoint(x, y));
+    // arithmetic shift is rounding to negative infinity, so it is valid for negative positions too
+    const int deltaZoom = mZoom - parentZoom;
+    return GeoTilePos(parentZoom, QPoint(mPos.x() >> deltaZoom, mPos.y() >> deltaZoom));
+}
+
+GeoTilePos GeoTilePos::child(int childZoom, const QPoint& offset) const
+{
+    if (childZoom <= mZoom) {
+        return GeoTilePos();
+    }
+    const int deltaZoom = childZoom - mZoom;
+    return GeoTilePos(childZoom, QPoint((mPos.x() << deltaZoom) + offset.x(), (mPos.y() << deltaZoom) + offset.y()));
 }
 
 GeoRect GeoTilePos::toGeoRect() const
@@ -357,14 +485,86 @@ QString GeoTilePos::toQuadKey() const
     return quadKey;
 }
 
+quint64 GeoTilePos::toMorton() const
+{
+    return spreadBits(static_cast<quint32>(mPos.x())) | (spreadBits(static_cast<quint32>(mPos.y())) << 1);
+}
+
+GeoTileId GeoTilePos::toId() const
+{
+    Q_ASSERT(mZoom >= 0 && mZoom <= tileIdMaxZoom);
+    const int shift = 2 * (tileIdMaxZoom - mZoom);
+    return ((toMorton() << shift) << tileIdZoomBits) | static_cast<quint64>(mZoom);
+}
+
+GeoTileId GeoTilePos::descendantsIdEnd() const
+{
+    Q_ASSERT(mZoom >= 0 && mZoom <= tileIdMaxZoom);
+    const int shift = 2 * (tileIdMaxZoom - mZoom);
+    return ((toMorton() + 1) << shift) << tileIdZoomBits;
+}
+
+GeoTilePos GeoTilePos::fromId(GeoTileId id)
+{
+    const int zoom = static_cast<int>(id & tileIdZoomMask);
+    const int shift = 2 * (tileIdMaxZoom - zoom);
+    return fromMorton(zoom, (id >> tileIdZoomBits) >> shift);
+}
+
+GeoTilePos GeoTilePos::fromQuadKey(const QString& quadKey)
+{
+    int x = 0;
+    int y = 0;
+    for (const QChar& digit : quadKey) {
+        const int value = digit.toLatin1() - '0';
+        x = (x << 1) | (value & 1);
+        y = (y << 1) | ((value >> 1) & 1);
+    }
+    return GeoTilePos(quadKey.size(), QPoint(x, y));
+}
+
+GeoTilePos GeoTilePos::fromMorton(int zoom, quint64 morton)
+{
+    const int x = static_cast<int>(compactBits(morton));
+    const int y = static_cast<int>(compactBits(morton >> 1));
+    return GeoTilePos(zoom, QPoint(x, y));
+}
+
 GeoTilePos GeoTilePos::geoToTilePos(int zoom, const GeoPos& geoPos)
 {
-    const double lon = geoPos.longitude();
-    const double lat = geoPos.latitude();
-    const double x = floor((lon + 180.0) / 360.0 * pow(2.0, zoom));
-    const double y =
-            floor((1.0 - log(tan(lat * M_PI / 180.0) + 1.0 / cos(lat * M_PI / 180.0)) / M_PI) / 2.0 * pow(2.0, zoom));
-    return GeoTilePos(zoom, QPoint(static_cast<int>(x), static_cast<int>(y)));
+    const double size = std::ldexp(1.0, zoom);
+    const double sinLat = std::sin(geoPos.latitude() * M_PI / 180.0);
+    const double x = (geoPos.longitude() + 180.0) / 360.0 * size;
+    const double y = (0.5 - std::log((1.0 + sinLat) / (1.0 - sinLat)) / (4.0 * M_PI)) * size;
+    return GeoTilePos(zoom, QPoint(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y))));
+}
+
+QVector<GeoTilePos> GeoTilePos::geoToTilePos(int zoom, const QVector<GeoPos>& geoPos)
+{
+    const double size = std::ldexp(1.0, zoom);
+    const double xFactor = size / 360.0;
+    const double yFactor = size / (4.0 * M_PI);
+    const double latFactor = M_PI / 180.0;
+    QVector<GeoTilePos> result;
+    result.reserve(geoPos.size());
+    for (const GeoPos& pos : geoPos) {
+        const double sinLat = std::sin(pos.latitude() * latFactor);
+        const double x = (pos.longitude() + 180.0) * xFactor;
+        const double y = 0.5 * size - std::log((1.0 + sinLat) / (1.0 - sinLat)) * yFactor;
+        result.append(GeoTilePos(zoom, QPoint(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y)))));
+    }
+    return result;
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+size_t qHash(const GeoTilePos& key, size_t seed)
+#else
+uint qHash(const GeoTilePos& key, uint seed)
+#endif
+{
+    const quint64 x = static_cast<quint32>(key.pos().x());
+    const quint64 y = static_cast<quint32>(key.pos().y());
+    return ::qHash((static_cast<quint64>(key.zoom()) << 58) ^ (x << 29) ^ y, seed);
 }
 
 QTransform createTransfrom(const QPointF& projAnchor, double scale, double azimuth)
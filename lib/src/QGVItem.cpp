@@ -27,6 +27,7 @@ QGVItem::QGVItem(QGVItem* parent)
     mVisible = true;
     mSelectable = false;
     mSelected = false;
+    mProjectionPrepared = false;
 }
 
 QGVItem::~QGVItem()
@@ -265,6 +266,24 @@ void QGVItem::update()
     onUpdate();
 }
 
+/*
+ * Called by map for every item from worker threads before onProjection() when projection is changed. Method should
+ * only calculate projected geometry of item itself, access to scene, map or other items is not allowed. Results can
+ * be used in onProjection() when isProjectionPrepared() is true, otherwise onProjection() calculates them itself.
+ */
+void QGVItem::onProjectionPrepare(const QGVProjection* /*projection*/)
+{
+}
+
+/*
+ * Estimated work of onProjectionPrepare() in projected points. Map uses worker threads only when total cost of all
+ * items is worth thread hand-off, so item with heavy geometry should return number of its points.
+ */
+int QGVItem::projectionCost() const
+{
+    return 1;
+}
+
 void QGVItem::onProjection(QGVMap* geoMap)
 {
     for (QGVItem* obj : mChildrens) {
@@ -281,10 +300,24 @@ void QGVItem::onCamera(const QGVCameraState& oldState, const QGVCameraState& new
     }
 }
 
+void QGVItem::onTrajectory(const QList<QGVCameraState>& states)
+{
+    for (QGVItem* obj : mChildrens) {
+        if (obj->isVisible()) {
+            obj->onTrajectory(states);
+        }
+    }
+}
+
 void QGVItem::onUpdate()
 {
 }
 
+bool QGVItem::isProjectionPrepared() const
+{
+    return mProjectionPrepared;
+}
+
 void QGVItem::onClean()
 {
     for (QGVItem* obj : mChildrens) {
@@ -32,11 +32,33 @@ const QStringList URLTemplates = {
     "http://bdgex.eb.mil.br/mapcache?request=GetMap&service=WMS&version=1.1.1&layers=ctmmultiescalas_mercator&srs=EPSG%3A3857&bbox=lonLeft,latBottom,lonRigth,latTop&width=WIDTH&height=HEIGHT&format=image%2Fpng"
 };
 // clang-format on
+
+QGVTileGrid gridForUrl(const QString& url)
+{
+    // WMS in geographic coordinates is requested by tiles of geographic grid and warped to map projection
+    if (url.contains("EPSG%3A4326", Qt::CaseInsensitive) || url.contains("EPSG:4326", Qt::CaseInsensitive)) {
+        return QGVTileGrid::geographic();
+    }
+    return QGVTileGrid::mercator();
+}
+
+// WMS url has bare placeholders for bounding box and size of image
+const QStringList bboxPlaceholders = { "lonLeft", "latBottom", "lonRigth", "latTop", "WIDTH", "HEIGHT" };
+
+QGVUrlTemplate templateForUrl(QString url)
+{
+    for (const QString& placeholder : bboxPlaceholders) {
+        url.replace(placeholder, "${" + placeholder + "}");
+    }
+    return QGVUrlTemplate(url, bboxPlaceholders);
+}
 }
 
 QGVLayerBDGEx::QGVLayerBDGEx(int serverNumber)
     : mUrl(URLTemplates.value(serverNumber))
 {
+    mUrlTemplate = templateForUrl(mUrl);
+    setTileGrid(gridForUrl(mUrl));
     setName("Banco de Dados Geográfico do Exército");
     setDescription("Copyrights: \"Termo de Uso do BDGEx\"");
 }
@@ -44,6 +66,8 @@ QGVLayerBDGEx::QGVLayerBDGEx(int serverNumber)
 QGVLayerBDGEx::QGVLayerBDGEx(const QString& url)
     : mUrl(url)
 {
+    mUrlTemplate = templateForUrl(mUrl);
+    setTileGrid(gridForUrl(mUrl));
     setName("Padrão");
     setDescription("Carta Topográfica Matricial");
 }
@@ -51,6 +75,8 @@ QGVLayerBDGEx::QGVLayerBDGEx(const QString& url)
 void QGVLayerBDGEx::setUrl(const QString& url)
 {
     mUrl = url;
+    mUrlTemplate = templateForUrl(mUrl);
+    setTileGrid(gridForUrl(mUrl));
 }
 
 QString QGVLayerBDGEx::getUrl() const
@@ -70,18 +96,18 @@ int QGVLayerBDGEx::maxZoomlevel() const
 
 QString QGVLayerBDGEx::tilePosToUrl(const QGV::GeoTilePos& tilePos) const
 {
-    QString url = mUrl;
-    QGV::GeoRect rect = tilePos.toGeoRect();
-    url.replace("lonLeft", QString::number(rect.lonLeft(), 'f', 6));
-    url.replace("latBottom", QString::number(rect.latBottom(), 'f', 6));
-    url.replace("lonRigth", QString::number(rect.lonRigth(), 'f', 6));
-    url.replace("latTop", QString::number(rect.latTop(), 'f', 6));
+    QGV::GeoRect rect = getTileGrid().toGeoRect(tilePos);
     double m_width = rect.lonRigth() - rect.lonLeft();
     double m_height = rect.latTop() - rect.latBottom();
     double ratio = m_width / m_height;
     int width_pixels = 900;
     int height_pixels = (int)((double)width_pixels / ratio);
-    url.replace("WIDTH", QString::number(width_pixels));
-    url.replace("HEIGHT", QString::number(height_pixels));
-    return url;
+    // values are in order of bboxPlaceholders
+    return mUrlTemplate.toUrl(tilePos,
+                              { QString::number(rect.lonLeft(), 'f', 6),
+                                QString::number(rect.latBottom(), 'f', 6),
+                                QString::number(rect.lonRigth(), 'f', 6),
+                                QString::number(rect.latTop(), 'f', 6),
+                                QString::number(width_pixels),
+                                QString::number(height_pixels) });
 }
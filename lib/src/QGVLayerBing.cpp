@@ -48,6 +48,7 @@ QGVLayerBing::QGVLayerBing(QGV::TilesType type, QLocale locale, int serverNumber
     , mServerNumber(serverNumber)
 {
     createName();
+    createUrl();
     setDescription("Copyrights ©Microsoft");
 }
 
@@ -55,12 +56,14 @@ void QGVLayerBing::setType(QGV::TilesType type)
 {
     mType = type;
     createName();
+    createUrl();
 }
 
 void QGVLayerBing::setLocale(const QLocale& locale)
 {
     mLocale = locale;
     createName();
+    createUrl();
 }
 
 QGV::TilesType QGVLayerBing::getType() const
@@ -85,6 +88,19 @@ void QGVLayerBing::createName()
     setName("Bing Maps (" + adapter[mType] + " " + mLocale.name() + ")");
 }
 
+void QGVLayerBing::createUrl()
+{
+    // templates are parsed once per type or locale change instead of each tile, selected server goes first and
+    // other servers are used as mirrors
+    const QStringList list = URLTemplates.value(mType);
+    mUrlTemplates.clear();
+    for (int i = 0; i < list.size(); ++i) {
+        QGVUrlTemplate urlTemplate(list.value((mServerNumber + i) % list.size()).toLower(), { "lcl" });
+        urlTemplate.bind("lcl", mLocale.name());
+        mUrlTemplates.append(urlTemplate);
+    }
+}
+
 int QGVLayerBing::minZoomlevel() const
 {
     return 1;
@@ -97,9 +113,15 @@ int QGVLayerBing::maxZoomlevel() const
 
 QString QGVLayerBing::tilePosToUrl(const QGV::GeoTilePos& tilePos) const
 {
-    const QStringList& list = URLTemplates[mType];
-    QString url = list.value(mServerNumber).toLower();
-    url.replace("${lcl}", mLocale.name());
-    url.replace("${qk}", tilePos.toQuadKey());
-    return url;
+    return tilePosToMirrorUrl(tilePos, 0);
+}
+
+int QGVLayerBing::mirrorsCount() const
+{
+    return qMax(1, mUrlTemplates.size());
+}
+
+QString QGVLayerBing::tilePosToMirrorUrl(const QGV::GeoTilePos& tilePos, int mirror) const
+{
+    return mUrlTemplates.value(mirror).toUrl(tilePos);
 }
@@ -51,6 +51,7 @@ QGVLayerGoogle::QGVLayerGoogle(QGV::TilesType type, QLocale locale, int serverNu
     , mServerNumber(serverNumber)
 {
     createName();
+    createUrl();
     setDescription("Copyrights ©Google");
 }
 
@@ -58,12 +59,14 @@ void QGVLayerGoogle::setType(QGV::TilesType type)
 {
     mType = type;
     createName();
+    createUrl();
 }
 
 void QGVLayerGoogle::setLocale(const QLocale& locale)
 {
     mLocale = locale;
     createName();
+    createUrl();
 }
 
 QGV::TilesType QGVLayerGoogle::getType() const
@@ -88,6 +91,19 @@ void QGVLayerGoogle::createName()
     setName("Google Maps (" + adapter[mType] + " " + mLocale.name() + ")");
 }
 
+void QGVLayerGoogle::createUrl()
+{
+    // templates are parsed once per type or locale change instead of each tile, selected server goes first and
+    // other servers are used as mirrors
+    const QStringList list = URLTemplates.value(mType);
+    mUrlTemplates.clear();
+    for (int i = 0; i < list.size(); ++i) {
+        QGVUrlTemplate urlTemplate(list.value((mServerNumber + i) % list.size()).toLower(), { "lcl" });
+        urlTemplate.bind("lcl", mLocale.name());
+        mUrlTemplates.append(urlTemplate);
+    }
+}
+
 int QGVLayerGoogle::minZoomlevel() const
 {
     return 0;
@@ -100,11 +116,15 @@ int QGVLayerGoogle::maxZoomlevel() const
 
 QString QGVLayerGoogle::tilePosToUrl(const QGV::GeoTilePos& tilePos) const
 {
-    const QStringList& list = URLTemplates[mType];
-    QString url = list.value(mServerNumber).toLower();
-    url.replace("${lcl}", mLocale.name());
-    url.replace("${z}", QString::number(tilePos.zoom()));
-    url.replace("${x}", QString::number(tilePos.pos().x()));
-    url.replace("${y}", QString::number(tilePos.pos().y()));
-    return url;
+    return tilePosToMirrorUrl(tilePos, 0);
+}
+
+int QGVLayerGoogle::mirrorsCount() const
+{
+    return qMax(1, mUrlTemplates.size());
+}
+
+QString QGVLayerGoogle::tilePosToMirrorUrl(const QGV::GeoTilePos& tilePos, int mirror) const
+{
+    return mUrlTemplates.value(mirror).toUrl(tilePos);
 }
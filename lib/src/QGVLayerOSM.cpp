@@ -28,25 +28,40 @@ const QStringList URLTemplates = {
     "http://c.tile.openstreetmap.org/${z}/${x}/${y}.png",
 };
 // clang-format on
+const double retinaPixelRatio = 1.5;
 }
 
 QGVLayerOSM::QGVLayerOSM(int serverNumber)
     : mUrl(URLTemplates.value(serverNumber))
+    , mRetinaTilePixelSize(512)
 {
+    mUrlTemplate = QGVUrlTemplate(mUrl.toLower());
+    QStringList mirrors;
+    for (int i = 1; i < URLTemplates.size(); ++i) {
+        mirrors.append(URLTemplates.value((serverNumber + i) % URLTemplates.size()));
+    }
+    setMirrorUrls(mirrors);
     setName("OpenStreetMap");
     setDescription("Copyrights ©OpenStreetMap");
 }
 
 QGVLayerOSM::QGVLayerOSM(const QString& url)
     : mUrl(url)
+    , mRetinaTilePixelSize(512)
 {
+    mUrlTemplate = QGVUrlTemplate(mUrl.toLower());
     setName("Custom");
     setDescription("OSM-like map");
 }
 
+/*!
+ * Mirrors of previous url are dropped, they may serve other tiles.
+ */
 void QGVLayerOSM::setUrl(const QString& url)
 {
     mUrl = url;
+    mUrlTemplate = QGVUrlTemplate(mUrl.toLower());
+    setMirrorUrls({});
 }
 
 QString QGVLayerOSM::getUrl() const
@@ -54,6 +69,36 @@ QString QGVLayerOSM::getUrl() const
     return mUrl;
 }
 
+void QGVLayerOSM::setRetinaUrl(const QString& url, int tilePixelSize)
+{
+    mRetinaUrl = url;
+    mRetinaUrlTemplate = QGVUrlTemplate(mRetinaUrl.toLower());
+    mRetinaTilePixelSize = tilePixelSize;
+}
+
+QString QGVLayerOSM::getRetinaUrl() const
+{
+    return mRetinaUrl;
+}
+
+/*!
+ * Mirrors of main url, requests are spread between all of them.
+ * Tiles are cached by main url, so mirrors must provide the same tiles.
+ */
+void QGVLayerOSM::setMirrorUrls(const QStringList& urls)
+{
+    mMirrorUrls = urls;
+    mMirrorTemplates.clear();
+    for (const QString& url : mMirrorUrls) {
+        mMirrorTemplates.append(QGVUrlTemplate(url.toLower()));
+    }
+}
+
+QStringList QGVLayerOSM::getMirrorUrls() const
+{
+    return mMirrorUrls;
+}
+
 int QGVLayerOSM::minZoomlevel() const
 {
     return 0;
@@ -64,11 +109,33 @@ int QGVLayerOSM::maxZoomlevel() const
     return 20;
 }
 
+int QGVLayerOSM::tilePixelSize() const
+{
+    if (isRetina()) {
+        return mRetinaTilePixelSize;
+    }
+    return QGVLayerTilesOnline::tilePixelSize();
+}
+
 QString QGVLayerOSM::tilePosToUrl(const QGV::GeoTilePos& tilePos) const
 {
-    QString url = mUrl.toLower();
-    url.replace("${z}", QString::number(tilePos.zoom()));
-    url.replace("${x}", QString::number(tilePos.pos().x()));
-    url.replace("${y}", QString::number(tilePos.pos().y()));
-    return url;
+    return (isRetina()) ? mRetinaUrlTemplate.toUrl(tilePos) : mUrlTemplate.toUrl(tilePos);
+}
+
+int QGVLayerOSM::mirrorsCount() const
+{
+    return (isRetina()) ? 1 : 1 + mMirrorTemplates.size();
+}
+
+QString QGVLayerOSM::tilePosToMirrorUrl(const QGV::GeoTilePos& tilePos, int mirror) const
+{
+    if (isRetina() || mirror <= 0 || mirror > mMirrorTemplates.size()) {
+        return tilePosToUrl(tilePos);
+    }
+    return mMirrorTemplates[mirror - 1].toUrl(tilePos);
+}
+
+bool QGVLayerOSM::isRetina() const
+{
+    return !mRetinaUrl.isEmpty() && devicePixelRatio() >= retinaPixelRatio;
 }
@@ -18,12 +18,27 @@
 
 #include "QGVLayerTiles.h"
 #include "QGVDrawItem.h"
+#include "QGVMetrics.h"
+#include "Raster/QGVImage.h"
 
+#include <QSet>
 #include <QtMath>
 
+namespace {
+const qint64 velocityResetMs = 250;
+const int decodedMemoryKb = 64 * 1024;
+const int placeholderMinPixels = 16;
+const int defaultTilePixelSize = 256;
+// deepest zoom level which fits into GeoTileId
+const int maxTileZoom = 28;
+}
+
 QGVLayerTiles::QGVLayerTiles()
+    : mTileGrid(QGVTileGrid::mercator())
 {
     mCurZoom = -1;
+    mTilePixelSize = defaultTilePixelSize;
+    mDecoded.setMaxCost(decodedMemoryKb);
     sendToBack();
 }
 
@@ -63,6 +78,84 @@ void QGVLayerTiles::setCameraUpdatesDuringAnimation(bool value)
     qgvDebug() << "CameraUpdatesDuringAnimation changed to" << value;
 }
 
+void QGVLayerTiles::setPrefetchTrajectory(bool value)
+{
+    mPerfomanceProfile.PrefetchTrajectory = value;
+    qgvDebug() << "PrefetchTrajectory changed to" << value;
+}
+
+void QGVLayerTiles::setPrefetchVelocity(bool value)
+{
+    mPerfomanceProfile.PrefetchVelocity = value;
+    mLastMove.invalidate();
+    mVelocity = {};
+    qgvDebug() << "PrefetchVelocity changed to" << value;
+}
+
+void QGVLayerTiles::setPrefetchLookaheadMs(size_t value)
+{
+    mPerfomanceProfile.PrefetchLookaheadMs = value;
+    qgvDebug() << "PrefetchLookaheadMs changed to" << value;
+}
+
+void QGVLayerTiles::setPrefetchMaxTiles(size_t value)
+{
+    mPerfomanceProfile.PrefetchMaxTiles = value;
+    qgvDebug() << "PrefetchMaxTiles changed to" << value;
+}
+
+void QGVLayerTiles::setParentPlaceholders(bool value)
+{
+    mPerfomanceProfile.ParentPlaceholders = value;
+    if (!value) {
+        removeAllPlaceholders();
+        mDecoded.clear();
+    }
+    qgvDebug() << "ParentPlaceholders changed to" << value;
+}
+
+void QGVLayerTiles::setOverzoomLevels(size_t value)
+{
+    mPerfomanceProfile.OverzoomLevels = qMin(value, static_cast<size_t>(maxTileZoom));
+    qgvDebug() << "OverzoomLevels changed to" << mPerfomanceProfile.OverzoomLevels;
+}
+
+void QGVLayerTiles::setOpaqueTiles(bool value)
+{
+    mPerfomanceProfile.OpaqueTiles = value;
+    qgvDebug() << "OpaqueTiles changed to" << value;
+}
+
+void QGVLayerTiles::setTilePixelSize(int value)
+{
+    mTilePixelSize = qMax(1, value);
+    qgvDebug() << "TilePixelSize changed to" << mTilePixelSize;
+}
+
+/*!
+ * Tiles which are requested but not delivered yet, including overzoomed tiles waiting for their source.
+ */
+int QGVLayerTiles::countPendingTiles() const
+{
+    int count = mOverzoomWaiting.size();
+    for (const auto& zoomIndex : mIndex) {
+        for (const QGVDrawItem* tile : zoomIndex) {
+            if (tile == nullptr) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+/*!
+ * Requests which are being processed by tile source, base layer has no own requests.
+ */
+int QGVLayerTiles::countRequestsInFlight() const
+{
+    return 0;
+}
+
 void QGVLayerTiles::onProjection(QGVMap* geoMap)
 {
     QGVLayer::onProjection(geoMap);
@@ -76,6 +169,8 @@ void QGVLayerTiles::onCamera(const QGVCameraState& oldState, const QGVCameraStat
         return;
     }
 
+    processVelocity(oldState, newState);
+
     bool needUpdate = true;
 
     if (newState.animation()) {
@@ -97,6 +192,26 @@ void QGVLayerTiles::onCamera(const QGVCameraState& oldState, const QGVCameraStat
     }
 }
 
+void QGVLayerTiles::onTrajectory(const QList<QGVCameraState>& states)
+{
+    QGVLayer::onTrajectory(states);
+
+    if (!mPerfomanceProfile.PrefetchTrajectory || getMap() == nullptr || !isVisible()) {
+        return;
+    }
+
+    QList<QGV::GeoTilePos> planned;
+    for (const QGVCameraState& state : states) {
+        const int zoom = scaleToZoom(state.scale());
+        if (zoom < minZoomlevel() || zoom > maxZoomlevel()) {
+            continue;
+        }
+        prefetchArea(zoom, state.projRect(), planned);
+    }
+    qgvDebug() << "prefetch" << planned.size() << "tiles along trajectory";
+    prefetchTiles(planned);
+}
+
 void QGVLayerTiles::onUpdate()
 {
     QGVLayer::onUpdate();
@@ -107,17 +222,29 @@ void QGVLayerTiles::onClean()
 {
     QGVLayer::onClean();
     mCurZoom = -1;
-    mCurRect = {};
+    mCurRects.clear();
     mIndex.clear();
+    mPlaceholders.clear();
+    mDecoded.clear();
+    mPrefetchPlan.clear();
+    mOverzoomWaiting.clear();
+    mOverzoomSources.clear();
+    mLastMove.invalidate();
+    mVelocity = {};
     deleteItems();
 }
 
 void QGVLayerTiles::onTile(const QGV::GeoTilePos& tilePos, QGVDrawItem* tileObj)
 {
-    if (tilePos.zoom() != mCurZoom || !mCurRect.contains(tilePos.pos())) {
+    if (mOverzoomSources.contains(tilePos)) {
+        onOverzoomSource(tilePos, tileObj);
+        return;
+    }
+    if (tilePos.zoom() != mCurZoom || !isTileActive(tilePos)) {
         delete tileObj;
         return;
     }
+    QGVMetrics::Scope scope(QGVMetrics::Stage::AddToScene);
     addTile(tilePos, tileObj);
 
     removeAllAbove(tilePos);
@@ -125,19 +252,114 @@ void QGVLayerTiles::onTile(const QGV::GeoTilePos& tilePos, QGVDrawItem* tileObj)
     const int fromZoom = minZoomlevel();
     const int toZoom = tilePos.zoom() - 1;
     for (int zoom = fromZoom; zoom <= toZoom; ++zoom) {
-        for (const QGV::GeoTilePos& below : existingTiles(zoom)) {
-            if (below.contains(tilePos)) {
-                removeWhenCovered(below);
-            }
+        const QGV::GeoTilePos below = tilePos.parent(zoom);
+        if (isTileExists(below)) {
+            removeWhenCovered(below);
         }
     }
 }
 
 int QGVLayerTiles::scaleToZoom(double scale) const
 {
-    const double scaleChange = 1 / scale;
+    // zoom is selected to have one tile pixel per one physical pixel of screen
+    const double pixelScale = scale * devicePixelRatio() * defaultTilePixelSize / tilePixelSize();
+    const double scaleChange = 1 / pixelScale;
     const int newZoom = qRound((17.0 - qLn(scaleChange) * M_LOG2E));
-    return newZoom;
+    return newZoom + mTileGrid.zoomOffset();
+}
+
+int QGVLayerTiles::tilePixelSize() const
+{
+    return mTilePixelSize;
+}
+
+double QGVLayerTiles::devicePixelRatio() const
+{
+    if (getMap() == nullptr) {
+        return 1.0;
+    }
+    return getMap()->devicePixelRatioF();
+}
+
+void QGVLayerTiles::setTileGrid(const QGVTileGrid& tileGrid)
+{
+    mTileGrid = tileGrid;
+    qgvDebug() << "TileGrid changed to" << mTileGrid.getProjection()->getID();
+}
+
+const QGVTileGrid& QGVLayerTiles::getTileGrid() const
+{
+    return mTileGrid;
+}
+
+void QGVLayerTiles::setTileGeometry(QGVImage* tile, const QGV::GeoTilePos& tilePos) const
+{
+    // pixel format is selected before image is loaded, so image is converted only once
+    tile->setOpaque(mPerfomanceProfile.OpaqueTiles);
+    tile->setGeometry(mTileGrid.toGeoRect(tilePos), mTileGrid.getProjection());
+}
+
+bool QGVLayerTiles::isOpaqueTiles() const
+{
+    return mPerfomanceProfile.OpaqueTiles;
+}
+
+void QGVLayerTiles::prefetch(const QGV::GeoTilePos& /*tilePos*/)
+{
+}
+
+/*!
+ * Prefetches which are still in progress and not listed in keep are not needed anymore.
+ */
+void QGVLayerTiles::abortPrefetch(const QSet<QGV::GeoTilePos>& /*keep*/)
+{
+}
+
+QGVDrawItem* QGVLayerTiles::placeholder(const QGV::GeoTilePos& tilePos)
+{
+    for (int zoom = tilePos.zoom() - 1; zoom >= minZoomlevel(); --zoom) {
+        const QGV::GeoTilePos ancestor = tilePos.parent(zoom);
+        const QImage* image = mDecoded.object(ancestor);
+        if (image == nullptr) {
+            continue;
+        }
+        return cropTile(tilePos, ancestor, *image, placeholderMinPixels, "placeholder");
+    }
+    return nullptr;
+}
+
+QImage QGVLayerTiles::decodedTile(const QGV::GeoTilePos& tilePos)
+{
+    const QImage* image = mDecoded.object(tilePos);
+    if (image == nullptr) {
+        return {};
+    }
+    return *image;
+}
+
+void QGVLayerTiles::storeDecoded(const QGV::GeoTilePos& tilePos, const QImage& image)
+{
+    const int cost = qMax(1, static_cast<int>(image.sizeInBytes() / 1024));
+    mDecoded.insert(tilePos, new QImage(image), cost);
+}
+
+/*!
+ * Tile upscaled from the nearest ancestor which is no more than OverzoomLevels above.
+ * Used above maxZoomlevel and for tiles which can't be delivered (offline mode, missing tile).
+ */
+QGVDrawItem* QGVLayerTiles::overzoom(const QGV::GeoTilePos& tilePos)
+{
+    const int fromZoom = qMin(tilePos.zoom() - 1, maxZoomlevel());
+    const int toZoom = qMax(minZoomlevel(), tilePos.zoom() - static_cast<int>(mPerfomanceProfile.OverzoomLevels));
+    for (int zoom = fromZoom; zoom >= toZoom; --zoom) {
+        const QGV::GeoTilePos ancestor = tilePos.parent(zoom);
+        const QImage image = decodedTile(ancestor);
+        if (image.isNull()) {
+            continue;
+        }
+        return cropTile(tilePos, ancestor, image, 1, "overzoom");
+    }
+    return nullptr;
 }
 
 void QGVLayerTiles::processCamera()
@@ -145,13 +367,10 @@ void QGVLayerTiles::processCamera()
     if (getMap() == nullptr || !isVisible()) {
         return;
     }
-    const QGVProjection* projection = getMap()->getProjection();
     const QGVCameraState camera = getMap()->getCamera();
-    const QRectF areaProjRect = camera.projRect().intersected(projection->boundaryProjRect());
-    const QGV::GeoRect areaGeoRect = projection->projToGeo(areaProjRect);
 
     int originZoom = scaleToZoom(camera.scale());
-    int newZoom = qMin(maxZoomlevel(), qMax(minZoomlevel(), originZoom));
+    int newZoom = qMin(maxOverzoomlevel(), qMax(minZoomlevel(), originZoom));
     if (newZoom != originZoom) {
         return;
     }
@@ -161,15 +380,17 @@ void QGVLayerTiles::processCamera()
 
     const int margin = (zoomChanged) ? static_cast<int>(mPerfomanceProfile.TilesMarginWithZoomChange)
                                      : static_cast<int>(mPerfomanceProfile.TilesMarginNoZoomChange);
-    const int sizePerZoom = static_cast<int>(qPow(2, mCurZoom));
-    const QRect maxRect = QRect(QPoint(0, 0), QPoint(sizePerZoom, sizePerZoom));
-    const QPoint topLeft = QGV::GeoTilePos::geoToTilePos(mCurZoom, areaGeoRect.topLeft()).pos();
-    const QPoint bottomRight = QGV::GeoTilePos::geoToTilePos(mCurZoom, areaGeoRect.bottomRight()).pos();
-    QRect activeRect = QRect(topLeft, bottomRight);
-    activeRect = activeRect.adjusted(-margin, -margin, margin, margin);
-    activeRect = activeRect.intersected(maxRect);
-    const bool rectChanged = (!zoomChanged && (mCurRect != activeRect));
-    mCurRect = activeRect;
+    const QSize sizePerZoom = mTileGrid.tilesCount(mCurZoom);
+    const QRect maxRect = QRect(QPoint(0, 0), QPoint(sizePerZoom.width(), sizePerZoom.height()));
+    // view crossing antimeridian is covered by tiles from both sides of canonical world
+    QList<QRect> activeRects;
+    for (const QRectF& projRect : getMap()->foldProjRect(camera.projRect())) {
+        QRect activeRect = tilesRect(mCurZoom, projRect);
+        activeRect = activeRect.adjusted(-margin, -margin, margin, margin);
+        activeRects.append(activeRect.intersected(maxRect));
+    }
+    const bool rectChanged = (!zoomChanged && (mCurRects != activeRects));
+    mCurRects = activeRects;
 
     if (!zoomChanged && !rectChanged) {
         return;
@@ -177,8 +398,19 @@ void QGVLayerTiles::processCamera()
 
     if (zoomChanged) {
         qgvDebug() << "new active zoom" << mCurZoom;
+        if (!camera.animation()) {
+            // prefetch planned for other zoom levels is useless now
+            QSet<QGV::GeoTilePos> keep;
+            for (const QGV::GeoTilePos& tilePos : mPrefetchPlan) {
+                if (tilePos.zoom() == mCurZoom) {
+                    keep.insert(tilePos);
+                }
+            }
+            mPrefetchPlan = keep;
+            abortPrefetch(mPrefetchPlan);
+        }
         const int fromZoom = minZoomlevel();
-        const int toZoom = maxZoomlevel();
+        const int toZoom = maxOverzoomlevel();
         for (int zoom = fromZoom; zoom <= toZoom; ++zoom) {
             if (zoom == mCurZoom) {
                 for (const QGV::GeoTilePos& current : existingTiles(zoom)) {
@@ -189,6 +421,8 @@ void QGVLayerTiles::processCamera()
                     if (!isTileFinished(nonCurrent)) {
                         qgvDebug() << "cancel non-finished" << nonCurrent;
                         removeTile(nonCurrent);
+                    } else if (zoom < mCurZoom && mPerfomanceProfile.ParentPlaceholders) {
+                        // checked again when placeholders for current zoom are added
                     } else if (zoom < mCurZoom) {
                         removeWhenCovered(nonCurrent);
                     }
@@ -199,41 +433,157 @@ void QGVLayerTiles::processCamera()
     }
 
     if (rectChanged) {
-        qgvDebug() << "new active rect" << mCurRect.topLeft() << mCurRect.bottomRight();
+        qgvDebug() << "new active rects" << mCurRects;
         for (const QGV::GeoTilePos& tilePos : existingTiles(mCurZoom)) {
-            if (!mCurRect.contains(tilePos.pos())) {
+            if (!isTileActive(tilePos)) {
                 qgvDebug() << "delete out of boundary view" << tilePos;
                 removeTile(tilePos);
             }
         }
     }
+    removeInactiveOverzoom();
 
     QMultiMap<qreal, QGV::GeoTilePos> missing;
-    for (int x = mCurRect.left(); x < mCurRect.right(); ++x) {
-        for (int y = mCurRect.top(); y < mCurRect.bottom(); ++y) {
-            const auto tilePos = QGV::GeoTilePos(mCurZoom, QPoint(x, y));
-            if (isTileExists(tilePos)) {
-                continue;
+    QSet<QGV::GeoTilePos> planned;
+    for (const QRect& curRect : mCurRects) {
+        for (int x = curRect.left(); x < curRect.right(); ++x) {
+            for (int y = curRect.top(); y < curRect.bottom(); ++y) {
+                const auto tilePos = QGV::GeoTilePos(mCurZoom, QPoint(x, y));
+                if (isTileExists(tilePos) || planned.contains(tilePos)) {
+                    continue;
+                }
+                planned.insert(tilePos);
+                qreal radius = qSqrt(qPow(x - curRect.center().x(), 2) + qPow(y - curRect.center().y(), 2));
+                missing.insert(radius, tilePos);
             }
-            qreal radius = qSqrt(qPow(x - mCurRect.center().x(), 2) + qPow(y - mCurRect.center().y(), 2));
-            missing.insert(radius, tilePos);
         }
     }
 
     for (const QGV::GeoTilePos& tilePos : missing) {
         addTile(tilePos, nullptr);
     }
+
+    if (zoomChanged && mPerfomanceProfile.ParentPlaceholders) {
+        for (int zoom = minZoomlevel(); zoom < mCurZoom; ++zoom) {
+            for (const QGV::GeoTilePos& below : existingTiles(zoom)) {
+                removeWhenCovered(below);
+            }
+        }
+    }
+}
+
+void QGVLayerTiles::processVelocity(const QGVCameraState& oldState, const QGVCameraState& newState)
+{
+    if (!mPerfomanceProfile.PrefetchVelocity || mCurZoom < 0) {
+        return;
+    }
+    if (newState.animation() || !qFuzzyCompare(oldState.scale(), newState.scale())) {
+        mLastMove.invalidate();
+        mVelocity = {};
+        return;
+    }
+    if (!mLastMove.isValid()) {
+        mLastMove.start();
+        mVelocity = {};
+        return;
+    }
+    const qint64 elapsed = qMax<qint64>(1, mLastMove.restart());
+    if (elapsed > velocityResetMs) {
+        mVelocity = {};
+        return;
+    }
+    const QPointF velocity = (newState.projCenter() - oldState.projCenter()) / static_cast<double>(elapsed);
+    mVelocity = (mVelocity + velocity) / 2.0;
+
+    const QPointF lookahead = mVelocity * static_cast<double>(mPerfomanceProfile.PrefetchLookaheadMs);
+    QList<QGV::GeoTilePos> planned;
+    prefetchArea(mCurZoom, newState.projRect().translated(lookahead), planned);
+    prefetchTiles(planned);
+}
+
+void QGVLayerTiles::prefetchArea(int zoom, const QRectF& projRect, QList<QGV::GeoTilePos>& planned)
+{
+    if (zoom > maxZoomlevel()) {
+        return;
+    }
+    const int maxTiles = static_cast<int>(mPerfomanceProfile.PrefetchMaxTiles);
+    for (const QRectF& part : getMap()->foldProjRect(projRect)) {
+        const QRect rect = tilesRect(zoom, part);
+        for (int x = rect.left(); x <= rect.right(); ++x) {
+            for (int y = rect.top(); y <= rect.bottom(); ++y) {
+                if (planned.size() >= maxTiles) {
+                    return;
+                }
+                const auto tilePos = QGV::GeoTilePos(zoom, QPoint(x, y));
+                if (isTileExists(tilePos) || planned.contains(tilePos)) {
+                    continue;
+                }
+                planned.append(tilePos);
+            }
+        }
+    }
+}
+
+void QGVLayerTiles::prefetchTiles(const QList<QGV::GeoTilePos>& planned)
+{
+    // new plan replaces previous one, tiles are prefetched in order of plan
+    mPrefetchPlan.clear();
+    for (const QGV::GeoTilePos& tilePos : planned) {
+        mPrefetchPlan.insert(tilePos);
+    }
+    abortPrefetch(mPrefetchPlan);
+    for (const QGV::GeoTilePos& tilePos : planned) {
+        prefetch(tilePos);
+    }
+}
+
+int QGVLayerTiles::maxOverzoomlevel() const
+{
+    return qMin(maxTileZoom, maxZoomlevel() + static_cast<int>(mPerfomanceProfile.OverzoomLevels));
+}
+
+QGVDrawItem* QGVLayerTiles::cropTile(const QGV::GeoTilePos& tilePos,
+                                     const QGV::GeoTilePos& ancestor,
+                                     const QImage& image,
+                                     int minPixels,
+                                     const QString& kind) const
+{
+    const int factor = 1 << (tilePos.zoom() - ancestor.zoom());
+    const QSizeF cellSize(static_cast<double>(image.width()) / factor, static_cast<double>(image.height()) / factor);
+    if (cellSize.width() < minPixels || cellSize.height() < minPixels) {
+        return nullptr;
+    }
+    const QPoint cell = tilePos.pos() - ancestor.pos() * factor;
+    const QRectF cropRect(QPointF(cell.x() * cellSize.width(), cell.y() * cellSize.height()), cellSize);
+    auto tile = new QGVImage();
+    setTileGeometry(tile, tilePos);
+    tile->loadImage(image.copy(cropRect.toAlignedRect()));
+    tile->setProperty("drawDebug",
+                      QString("%1\ntile(%2,%3,%4)\nfrom(%5,%6,%7)")
+                              .arg(kind)
+                              .arg(tilePos.zoom())
+                              .arg(tilePos.pos().x())
+                              .arg(tilePos.pos().y())
+                              .arg(ancestor.zoom())
+                              .arg(ancestor.pos().x())
+                              .arg(ancestor.pos().y()));
+    return tile;
+}
+
+QRect QGVLayerTiles::tilesRect(int zoom, const QRectF& projRect) const
+{
+    const QGVProjection* projection = getMap()->getProjection();
+    const QRectF areaProjRect = projRect.intersected(projection->boundaryProjRect());
+    const QGV::GeoRect areaGeoRect = projection->projToGeo(areaProjRect);
+    return mTileGrid.tilesRect(zoom, areaGeoRect);
 }
 
 void QGVLayerTiles::removeAllAbove(const QGV::GeoTilePos& tilePos)
 {
     const int fromZoom = tilePos.zoom() + 1;
-    const int toZoom = maxZoomlevel();
+    const int toZoom = maxOverzoomlevel();
     for (int zoom = fromZoom; zoom <= toZoom; ++zoom) {
-        for (const QGV::GeoTilePos& target : existingTiles(zoom)) {
-            if (!tilePos.contains(target)) {
-                continue;
-            }
+        for (const QGV::GeoTilePos& target : existingTiles(zoom, tilePos)) {
             qgvDebug() << "remove" << target << "above" << tilePos;
             removeTile(target);
         }
@@ -242,20 +592,30 @@ void QGVLayerTiles::removeAllAbove(const QGV::GeoTilePos& tilePos)
 
 void QGVLayerTiles::removeWhenCovered(const QGV::GeoTilePos& tilePos)
 {
-    const int zoomDelta = mCurZoom - tilePos.zoom() + 1;
-    const int neededCount = static_cast<int>(qPow(2, zoomDelta));
-    int count = neededCount;
-    for (const QGV::GeoTilePos& current : existingTiles(mCurZoom)) {
-        if (!tilePos.contains(current)) {
+    // only children inside active rects are ever requested, so tiles at edge of view are covered by part of them
+    const int zoomDelta = mCurZoom - tilePos.zoom();
+    const QRect childrenRect(tilePos.pos().x() << zoomDelta,
+                             tilePos.pos().y() << zoomDelta,
+                             1 << zoomDelta,
+                             1 << zoomDelta);
+    qint64 neededCount = 0;
+    for (const QRect& curRect : mCurRects) {
+        const QRect activeRect = curRect.intersected(childrenRect);
+        neededCount += static_cast<qint64>(activeRect.width()) * activeRect.height();
+    }
+    qint64 count = neededCount;
+    for (const QGV::GeoTilePos& current : existingTiles(mCurZoom, tilePos)) {
+        if (count == 0) {
+            break;
+        }
+        if (!isTileActive(current)) {
             continue;
         }
-        if (!isTileFinished(current)) {
+        // placeholder shows same image, so tile below is not needed
+        if (!isTileFinished(current) && !mPlaceholders.contains(current)) {
             break;
         }
         count--;
-        if (count == 0) {
-            break;
-        }
     }
     if (count == 0) {
         qgvDebug() << tilePos << "deleted by 100% coverage";
@@ -282,23 +642,113 @@ void QGVLayerTiles::addTile(const QGV::GeoTilePos& tilePos, QGVDrawItem* tileObj
         delete tileObj;
         return;
     }
+    if (tileObj == nullptr && tilePos.zoom() > maxZoomlevel()) {
+        if (mOverzoomWaiting.contains(tilePos)) {
+            return;
+        }
+        tileObj = overzoom(tilePos);
+        if (tileObj == nullptr) {
+            requestOverzoomSource(tilePos);
+            return;
+        }
+    }
     if (tileObj == nullptr) {
         qgvDebug() << "request tile" << tilePos;
-        mIndex[tilePos.zoom()][tilePos] = nullptr;
+        mIndex[tilePos.zoom()][tilePos.toId()] = nullptr;
+        QGVMetrics::instance()->add(QGVMetrics::Counter::TilesRequested);
         request(tilePos);
+        if (mPerfomanceProfile.ParentPlaceholders && isTileExists(tilePos) && !isTileFinished(tilePos)) {
+            addPlaceholder(tilePos);
+        }
     } else {
         qgvDebug() << "add tile" << tilePos;
-        mIndex[tilePos.zoom()][tilePos] = tileObj;
+        removePlaceholder(tilePos);
+        mIndex[tilePos.zoom()][tilePos.toId()] = tileObj;
         tileObj->setZValue(static_cast<qint16>(tilePos.zoom()));
         addItem(tileObj);
+        auto image = qobject_cast<QGVImage*>(tileObj);
+        const bool keepDecoded = mPerfomanceProfile.ParentPlaceholders || mPerfomanceProfile.OverzoomLevels > 0;
+        if (keepDecoded && image != nullptr && image->isImage()) {
+            storeDecoded(tilePos, image->getImage());
+        }
+    }
+}
+
+/*!
+ * Overzoomed tile has no decoded ancestor yet. Tile is not indexed, instead it waits in
+ * mOverzoomWaiting for its ancestor at maxZoomlevel, which is requested once for all children.
+ */
+void QGVLayerTiles::requestOverzoomSource(const QGV::GeoTilePos& tilePos)
+{
+    const QGV::GeoTilePos source = tilePos.parent(maxZoomlevel());
+    mOverzoomWaiting.insert(tilePos);
+    if (mOverzoomSources.contains(source)) {
+        return;
+    }
+    qgvDebug() << "request overzoom source" << source << "for" << tilePos;
+    mOverzoomSources.insert(source);
+    QGVMetrics::instance()->add(QGVMetrics::Counter::TilesRequested);
+    request(source);
+}
+
+void QGVLayerTiles::onOverzoomSource(const QGV::GeoTilePos& source, QGVDrawItem* tileObj)
+{
+    mOverzoomSources.remove(source);
+    auto image = qobject_cast<QGVImage*>(tileObj);
+    if (image != nullptr && image->isImage()) {
+        storeDecoded(source, image->getImage());
+    }
+    delete tileObj;
+
+    QList<QGV::GeoTilePos> children;
+    for (const QGV::GeoTilePos& tilePos : mOverzoomWaiting) {
+        if (tilePos.parent(source.zoom()) == source) {
+            children.append(tilePos);
+        }
+    }
+    for (const QGV::GeoTilePos& tilePos : children) {
+        mOverzoomWaiting.remove(tilePos);
+        QGVDrawItem* tile = overzoom(tilePos);
+        if (tile == nullptr) {
+            // source is not available, tile is requested again with next camera change
+            qgvDebug() << "no overzoom source for" << tilePos;
+            continue;
+        }
+        onTile(tilePos, tile);
+    }
+}
+
+void QGVLayerTiles::removeInactiveOverzoom()
+{
+    QSet<QGV::GeoTilePos> needed;
+    for (auto it = mOverzoomWaiting.begin(); it != mOverzoomWaiting.end();) {
+        if (it->zoom() != mCurZoom || !isTileActive(*it)) {
+            it = mOverzoomWaiting.erase(it);
+        } else {
+            needed.insert(it->parent(maxZoomlevel()));
+            ++it;
+        }
+    }
+    for (auto it = mOverzoomSources.begin(); it != mOverzoomSources.end();) {
+        if (needed.contains(*it)) {
+            ++it;
+            continue;
+        }
+        const QGV::GeoTilePos source = *it;
+        it = mOverzoomSources.erase(it);
+        qgvDebug() << "cancel overzoom source" << source;
+        QGVMetrics::instance()->add(QGVMetrics::Counter::TilesCanceled);
+        cancel(source);
     }
 }
 
 void QGVLayerTiles::removeTile(const QGV::GeoTilePos& tilePos)
 {
-    const auto tile = mIndex[tilePos.zoom()].take(tilePos);
+    removePlaceholder(tilePos);
+    const auto tile = mIndex[tilePos.zoom()].take(tilePos.toId());
     if (tile == nullptr) {
         qgvDebug() << "cancel tile" << tilePos;
+        QGVMetrics::instance()->add(QGVMetrics::Counter::TilesCanceled);
         cancel(tilePos);
     } else {
         qgvDebug() << "remove tile" << tilePos;
@@ -306,9 +756,44 @@ void QGVLayerTiles::removeTile(const QGV::GeoTilePos& tilePos)
     }
 }
 
+void QGVLayerTiles::addPlaceholder(const QGV::GeoTilePos& tilePos)
+{
+    QGVDrawItem* tileObj = placeholder(tilePos);
+    if (tileObj == nullptr) {
+        return;
+    }
+    qgvDebug() << "add placeholder" << tilePos;
+    removePlaceholder(tilePos);
+    mPlaceholders[tilePos] = tileObj;
+    tileObj->setZValue(static_cast<qint16>(tilePos.zoom()));
+    addItem(tileObj);
+}
+
+void QGVLayerTiles::removePlaceholder(const QGV::GeoTilePos& tilePos)
+{
+    delete mPlaceholders.take(tilePos);
+}
+
+void QGVLayerTiles::removeAllPlaceholders()
+{
+    qDeleteAll(mPlaceholders);
+    mPlaceholders.clear();
+}
+
 bool QGVLayerTiles::isTileExists(const QGV::GeoTilePos& tilePos) const
 {
-    return mIndex[tilePos.zoom()].contains(tilePos);
+    const auto it = mIndex.constFind(tilePos.zoom());
+    return it != mIndex.constEnd() && it->contains(tilePos.toId());
+}
+
+bool QGVLayerTiles::isTileActive(const QGV::GeoTilePos& tilePos) const
+{
+    for (const QRect& curRect : mCurRects) {
+        if (curRect.contains(tilePos.pos())) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool QGVLayerTiles::isTileFinished(const QGV::GeoTilePos& tilePos) const
@@ -316,10 +801,33 @@ bool QGVLayerTiles::isTileFinished(const QGV::GeoTilePos& tilePos) const
     if (!isTileExists(tilePos)) {
         return false;
     }
-    return mIndex[tilePos.zoom()][tilePos] != nullptr;
+    return mIndex.value(tilePos.zoom()).value(tilePos.toId(), nullptr) != nullptr;
 }
 
 QList<QGV::GeoTilePos> QGVLayerTiles::existingTiles(int zoom) const
 {
-    return mIndex[zoom].keys();
+    QList<QGV::GeoTilePos> result;
+    const auto it = mIndex.constFind(zoom);
+    if (it == mIndex.constEnd()) {
+        return result;
+    }
+    for (auto tile = it->constBegin(); tile != it->constEnd(); ++tile) {
+        result.append(QGV::GeoTilePos::fromId(tile.key()));
+    }
+    return result;
+}
+
+QList<QGV::GeoTilePos> QGVLayerTiles::existingTiles(int zoom, const QGV::GeoTilePos& root) const
+{
+    // descendants of root tile are forming contiguous range of ids
+    QList<QGV::GeoTilePos> result;
+    const auto it = mIndex.constFind(zoom);
+    if (it == mIndex.constEnd()) {
+        return result;
+    }
+    const QGV::GeoTileId end = root.descendantsIdEnd();
+    for (auto tile = it->lowerBound(root.toId()); tile != it->constEnd() && tile.key() < end; ++tile) {
+        result.append(QGV::GeoTilePos::fromId(tile.key()));
+    }
+    return result;
 }
@@ -17,25 +17,171 @@
  ****************************************************************************/
 
 #include "QGVLayerTilesOnline.h"
+#include "QGVLayerTilesOnlineDownload.h"
+#include "QGVLayerTilesOnlineWorker.h"
+#include "QGVMetrics.h"
 #include "Raster/QGVImage.h"
 
+#include <QNetworkDiskCache>
+#include <QThread>
+#include <QTimer>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+#include <QHttp1Configuration>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+const int prefetchMemoryKb = 32 * 1024;
+// prefetch must not occupy connections needed by visible tiles
+const int prefetchMaxInFlight = 16;
+
+// mirrors health tracking
+const int mirrorLatencySamples = 64;
+const double mirrorErrorWeight = 0.1;
+const double mirrorErrorLimit = 0.5;
+const double mirrorSlowFactor = 2.0;
+const qint64 mirrorSlowSlackMs = 20;
+const int mirrorProbeInterval = 20;
+const int hedgeMinSamples = 16;
+const qint64 hedgeMinDelayMs = 50;
+const char mirrorProperty[] = "qgvMirror";
+const char startedProperty[] = "qgvStarted";
+
+// failed requests handling
+const int retryDelayMs = 500;
+const qint64 missingTileExpireMs = 10 * 60 * 1000;
+const int missingTileMaxCount = 4096;
+const int offlineProbeMs = 15 * 1000;
+const double offlineErrorLimit = 0.8;
+
+// real client name is required by tile usage policies of public servers
+const char defaultUserAgent[] = "QGeoView/1.0 (Qt " QT_VERSION_STR ")";
+
+qint64 percentileOf(QVector<qint64> values, double percentile)
+{
+    if (values.isEmpty())
+    {
+        return 0;
+    }
+    const int index = qBound(0, static_cast<int>(percentile * (values.size() - 1)), values.size() - 1);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// format hint from "image/png" like content type
+QByteArray replyImageFormat(QNetworkReply* reply)
+{
+    const QByteArray type = reply->header(QNetworkRequest::ContentTypeHeader).toByteArray().toLower();
+    if (!type.startsWith("image/"))
+    {
+        return QByteArray();
+    }
+    return type.mid(6).split(';').first().trimmed();
+}
+
+// client errors except timeout and throttling mean that tile will never be delivered
+bool isMissingTileStatus(int status)
+{
+    return status >= 400 && status < 500 && status != 408 && status != 429;
+}
+
+// manager owns its cache, so disk cache is not shared but opened once more in the same directory
+void copyNetworkSettings(const QNetworkAccessManager* from, QNetworkAccessManager* to)
+{
+    if (from == nullptr)
+    {
+        return;
+    }
+    to->setProxy(from->proxy());
+    auto diskCache = qobject_cast<QNetworkDiskCache*>(from->cache());
+    if (diskCache != nullptr)
+    {
+        auto cache = new QNetworkDiskCache(to);
+        cache->setCacheDirectory(diskCache->cacheDirectory());
+        cache->setMaximumCacheSize(diskCache->maximumCacheSize());
+        to->setCache(cache);
+    }
+    else if (from->cache() != nullptr)
+    {
+        qgvWarning() << "network cache of type" << from->cache()->metaObject()->className() << "is not copied";
+    }
+}
+}
+
 QGVLayerTilesOnline::QGVLayerTilesOnline()
 {
     mCache.init_cache();
+    mPrefetched.setMaxCost(prefetchMemoryKb);
+    mMissing.setMaxCost(missingTileMaxCount);
+    mClock.start();
+    mProbeTimer.setInterval(offlineProbeMs);
+    connect(&mProbeTimer, &QTimer::timeout, this, &QGVLayerTilesOnline::onProbeTimer);
+    mUserAgent = defaultUserAgent;
 }
 
 QGVLayerTilesOnline::~QGVLayerTilesOnline()
 {
+    stopWorker();
     qDeleteAll(mRequest);
+    qDeleteAll(mHedge);
+    qDeleteAll(mPrefetch);
+    if (mDedicatedNetworkManager && mNetworkManager != nullptr)
+    {
+        // replies of download jobs are deleted together with manager, so jobs must drop them first
+        for (QNetworkReply* reply : mNetworkManager->findChildren<QNetworkReply*>())
+        {
+            reply->abort();
+        }
+    }
 }
 
 void QGVLayerTilesOnline::request(const QGV::GeoTilePos& tilePos)
 {
-    Q_ASSERT(QGV::getNetworkManager());
+    Q_ASSERT(getNetworkManager());
     QString tile_name(tilePosToUrl(tilePos));
     const QUrl url(tile_name);
-    QNetworkRequest request(url);
 
+    // server has no such tile, don't ask it again until record expires
+    if (isTileMissing(tilePos))
+    {
+        showMissingTile(tilePos);
+        return;
+    }
+
+    // tile was prefetched to memory or prefetch is still in progress
+    QScopedPointer<QByteArray> prefetched(mPrefetched.take(tilePos));
+    if (!prefetched.isNull())
+    {
+        QGVMetrics::instance()->add(QGVMetrics::Counter::TilesFromMemory);
+        auto tile = new QGVImage();
+        setTileGeometry(tile, tilePos);
+        tile->loadImage(*prefetched);
+        tile->setProperty("drawDebug",
+                          QString("%1\ntile(%2,%3,%4)")
+                                  .arg(tile_name)
+                                  .arg(tilePos.zoom())
+                                  .arg(tilePos.pos().x())
+                                  .arg(tilePos.pos().y()));
+        onTile(tilePos, tile);
+        return;
+    }
+    QNetworkReply* pending = mPrefetch.take(tilePos);
+    if (pending != nullptr)
+    {
+        qgvDebug() << "request adopts prefetch" << url;
+        mRequest[tilePos] = pending;
+        scheduleHedge(tilePos, pending);
+        return;
+    }
+    if (mWorker != nullptr)
+    {
+        // cache and network are handled by worker thread
+        mWorkerRequest.insert(tilePos);
+        sendWorkerTask(tilePos, QNetworkRequest::NormalPriority, true);
+        return;
+    }
 
     if (isCache)
     {
@@ -45,8 +191,9 @@ void QGVLayerTilesOnline::request(const QGV::GeoTilePos& tilePos)
         // check if file exists in cache
         if (rawImage.length())
         {
+            QGVMetrics::instance()->add(QGVMetrics::Counter::TilesFromDisk);
             auto tile = new QGVImage();
-            tile->setGeometry(tilePos.toGeoRect());
+            setTileGeometry(tile, tilePos);
             tile->loadImage(rawImage);
             tile->setProperty("drawDebug",
                           QString("%1\ntile(%2,%3,%4)")
@@ -63,78 +210,218 @@ void QGVLayerTilesOnline::request(const QGV::GeoTilePos& tilePos)
 
             if (isOffline)
             {
-                // offline mode
-                auto tile_rect = new QGVImage();
-                tile_rect->setProperty("drawDebug",
-                          QString("%1\ntile(%2,%3,%4)")
-                                  .arg(tile_name)
-                                  .arg(tilePos.zoom())
-                                  .arg(tilePos.pos().x())
-                                  .arg(tilePos.pos().y()));
-
-                // offline mode
-                //QImage image = mCache.getNoData("NO DATA");
-                //image.save("no_data.png", "png", 100);
-                tile_rect->setGeometry(tilePos.toGeoRect());
-                tile_rect->loadImage(mCache.getNoData("NO DATA"));
-
-                onTile(tilePos, tile_rect);
+                showOfflineTile(tilePos);
                 return;
             }
         }
     }
 
-    QSslConfiguration conf = request.sslConfiguration();
-    conf.setPeerVerifyMode(QSslSocket::VerifyNone);
-
-    request.setSslConfiguration(conf);
-    request.setRawHeader("User-Agent",
-                         "Mozilla/5.0 (Windows; U; MSIE "
-                         "6.0; Windows NT 5.1; SV1; .NET "
-                         "CLR 2.0.50727)");
-    request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
-    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+    if (mAutoOfflineActive)
+    {
+        if (!isProbeDue())
+        {
+            // network looks unavailable, tile is requested again when it is back
+            deferTile(tilePos);
+            return;
+        }
+        consumeProbe();
+    }
 
-    QNetworkReply* reply = QGV::getNetworkManager()->get(request);
+    QNetworkReply* reply = sendTileRequest(tilePos, QNetworkRequest::NormalPriority);
 
     mRequest[tilePos] = reply;
     //=== connect(object1, SIGNAL(signal(int param)), object2, SLOT(slot()))
     connect(reply, &QNetworkReply::finished, reply, [this, reply, tilePos]() { onReplyFinished(reply, tilePos); });
+    scheduleHedge(tilePos, reply);
 
-    qgvDebug() << "request" << url;
+    qgvDebug() << "request" << reply->url();
 
 }
 
 void QGVLayerTilesOnline::cancel(const QGV::GeoTilePos& tilePos)
 {
+    // pending retry is dropped together with request
+    mAttempts.remove(tilePos);
+    mDeferred.remove(tilePos);
+    updateProbeTimer();
     removeReply(tilePos);
+    if (mWorkerRequest.remove(tilePos) && !mWorkerPrefetch.contains(tilePos))
+    {
+        QGVLayerTilesOnlineWorker* worker = mWorker;
+        QMetaObject::invokeMethod(worker, [worker, tilePos]() { worker->cancel(tilePos); }, Qt::QueuedConnection);
+    }
 }
 
-void QGVLayerTilesOnline::onReplyFinished(QNetworkReply* reply, const QGV::GeoTilePos& tilePos)
+void QGVLayerTilesOnline::prefetch(const QGV::GeoTilePos& tilePos)
 {
-    if (reply->error() != QNetworkReply::NoError)
+    Q_ASSERT(getNetworkManager());
+    if (isOfflineActive() || mRequest.contains(tilePos) || mPrefetch.contains(tilePos) ||
+        mPrefetched.contains(tilePos) || mMissing.contains(tilePos) || mWorkerRequest.contains(tilePos) ||
+        mWorkerPrefetch.contains(tilePos))
+    {
+        return;
+    }
+    if (mPrefetch.size() + mWorkerPrefetch.size() >= prefetchMaxInFlight)
+    {
+        return;
+    }
+    if (mWorker != nullptr)
+    {
+        // worker checks cache and puts prefetched tile to cache only
+        mWorkerPrefetch.insert(tilePos);
+        sendWorkerTask(tilePos, QNetworkRequest::LowPriority, false);
+        return;
+    }
+    const QString tile_name(tilePosToUrl(tilePos));
+    if (isCache && mCache.hasTileInCache(tile_name))
     {
-        // if network error - increment offline counter
-        incOfflineCnt();
+        return;
+    }
+
+    QNetworkReply* reply = sendTileRequest(tilePos, QNetworkRequest::LowPriority);
+
+    mPrefetch[tilePos] = reply;
+    connect(reply, &QNetworkReply::finished, reply, [this, reply, tilePos]() { onPrefetchFinished(reply, tilePos); });
 
-        if (reply->error() != QNetworkReply::OperationCanceledError)
+    qgvDebug() << "prefetch" << tile_name;
+}
+
+void QGVLayerTilesOnline::abortPrefetch(const QSet<QGV::GeoTilePos>& keep)
+{
+    for (auto it = mPrefetch.begin(); it != mPrefetch.end();)
+    {
+        if (keep.contains(it.key()))
         {
-            qgvCritical() << "ERROR" << reply->errorString();
+            ++it;
+            continue;
         }
-        removeReply(tilePos);
-        return;
+        qgvDebug() << "abort prefetch" << it.key();
+        QNetworkReply* reply = it.value();
+        it = mPrefetch.erase(it);
+        reply->abort();
+        reply->deleteLater();
     }
-    const auto rawImage = reply->readAll();
+    for (auto it = mWorkerPrefetch.begin(); it != mWorkerPrefetch.end();)
+    {
+        // prefetch adopted by request is not aborted
+        if (keep.contains(*it) || mWorkerRequest.contains(*it))
+        {
+            ++it;
+            continue;
+        }
+        const QGV::GeoTilePos tilePos = *it;
+        it = mWorkerPrefetch.erase(it);
+        QGVLayerTilesOnlineWorker* worker = mWorker;
+        QMetaObject::invokeMethod(worker, [worker, tilePos]() { worker->cancel(tilePos); }, Qt::QueuedConnection);
+    }
+}
 
-    // save to file
-    if (isCache)
+QImage QGVLayerTilesOnline::decodedTile(const QGV::GeoTilePos& tilePos)
+{
+    QImage image = QGVLayerTiles::decodedTile(tilePos);
+    if (!image.isNull() || !isCache)
+    {
+        return image;
+    }
+    const QString tile_name(tilePosToUrl(tilePos));
+    if (!mCache.hasTileInCache(tile_name))
+    {
+        return image;
+    }
+    image = QImage::fromData(mCache.getTileFromCache(tilePos, tile_name, getName()));
+    if (!image.isNull())
+    {
+        storeDecoded(tilePos, image);
+    }
+    return image;
+}
+
+QNetworkReply* QGVLayerTilesOnline::sendRequest(const QUrl& url, QNetworkRequest::Priority priority)
+{
+    return getNetworkManager()->get(makeRequest(url, priority));
+}
+
+QNetworkRequest QGVLayerTilesOnline::makeRequest(const QUrl& url, QNetworkRequest::Priority priority) const
+{
+    QNetworkRequest request(url);
+
+    QSslConfiguration conf = request.sslConfiguration();
+    conf.setPeerVerifyMode(QSslSocket::VerifyNone);
+
+    request.setSslConfiguration(conf);
+    request.setRawHeader("User-Agent", mUserAgent);
+    // HTTP/2 multiplexes all tiles over one connection, pipelining is used by HTTP/1.1 servers
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, mHttp2);
+    request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    if (mConnectionsPerHost > 0)
+    {
+        QHttp1Configuration http1;
+        http1.setNumberOfConnectionsPerHost(static_cast<qsizetype>(mConnectionsPerHost));
+        request.setHttp1Configuration(http1);
+    }
+#endif
+#if QT_VERSION >= QT_VERSION_CHECK(6, 3, 0)
+    if (mKeepAliveTimeout > 0)
+    {
+        request.setAttribute(QNetworkRequest::ConnectionCacheExpiryTimeoutSecondsAttribute, mKeepAliveTimeout);
+    }
+#endif
+    request.setPriority(priority);
+    return request;
+}
+
+void QGVLayerTilesOnline::onReplyFinished(QNetworkReply* reply, const QGV::GeoTilePos& tilePos)
+{
+    onMirrorFinished(reply);
+
+    // request to one mirror may be hedged by request to another, first successful reply wins
+    QNetworkReply* primary = mRequest.value(tilePos, nullptr);
+    QNetworkReply* hedge = mHedge.value(tilePos, nullptr);
+    if (reply != primary && reply != hedge)
     {
-        mCache.putTileToCache(tilePos, reply->url().toString(), getName(), rawImage);
+        // reply is cancelled or lost the race
+        return;
+    }
+    QNetworkReply* other = (reply == primary) ? hedge : primary;
+    if (other != nullptr)
+    {
+        mHedge.remove(tilePos);
+        if (reply->error() != QNetworkReply::NoError && !other->isFinished())
+        {
+            // other mirror can still deliver the tile
+            mRequest[tilePos] = other;
+            reply->deleteLater();
+            return;
+        }
+        mRequest[tilePos] = reply;
+        other->abort();
+        other->deleteLater();
     }
 
+    if (reply->error() != QNetworkReply::NoError)
+    {
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        const QString error = reply->errorString();
+        removeReply(tilePos);
+        onRequestFailed(tilePos, status, error);
+        return;
+    }
     auto tile = new QGVImage();
-    tile->setGeometry(tilePos.toGeoRect());
-    tile->loadImage(rawImage);
+    setTileGeometry(tile, tilePos);
+    if (isCache)
+    {
+        // same bytes are shared by cache writer and decoder, no copy is made
+        const QByteArray rawImage = reply->readAll();
+        mCache.putTileToCache(tilePos, tilePosToUrl(tilePos), getName(), rawImage);
+        tile->loadImage(rawImage);
+    }
+    else
+    {
+        // decode directly from reply buffer
+        tile->loadImage(reply, replyImageFormat(reply));
+    }
     tile->setProperty("drawDebug",
                       QString("%1\ntile(%2,%3,%4)")
                               .arg(reply->url().toString())
@@ -142,11 +429,148 @@ void QGVLayerTilesOnline::onReplyFinished(QNetworkReply* reply, const QGV::GeoTi
                               .arg(tilePos.pos().x())
                               .arg(tilePos.pos().y()));
     removeReply(tilePos);
+    mAttempts.remove(tilePos);
+    QGVMetrics::instance()->add(QGVMetrics::Counter::TilesFromNetwork);
+    onTile(tilePos, tile);
+    decOfflineCnt();
+}
+
+void QGVLayerTilesOnline::sendWorkerTask(const QGV::GeoTilePos& tilePos, QNetworkRequest::Priority priority, bool decode)
+{
+    QGVLayerTilesOnlineWorker::Task task;
+    task.tilePos = tilePos;
+    task.tileName = tilePosToUrl(tilePos);
+    task.provider = getName();
+    task.mirror = selectMirror(-1);
+    task.request = makeRequest(QUrl(tilePosToMirrorUrl(tilePos, task.mirror)), priority);
+    task.cache = isCache;
+    task.network = !(isCache && isOffline);
+    if (task.network && mAutoOfflineActive)
+    {
+        task.network = isProbeDue();
+        if (task.network)
+        {
+            consumeProbe();
+        }
+    }
+    task.decode = decode;
+    task.opaque = isOpaqueTiles();
+    task.queuedUs = QGVMetrics::instance()->nowUs();
+
+    QGVLayerTilesOnlineWorker* worker = mWorker;
+    QMetaObject::invokeMethod(worker, [worker, task]() { worker->fetch(task); }, Qt::QueuedConnection);
+    qgvDebug() << "worker" << (decode ? "request" : "prefetch") << task.request.url();
+}
+
+void QGVLayerTilesOnline::onWorkerLoaded(const QGV::GeoTilePos& tilePos,
+                                         const QImage& image,
+                                         const QString& source,
+                                         bool decoded)
+{
+    mWorkerPrefetch.remove(tilePos);
+    // result of prefetch is not an image, request queued after it is answered by its own result
+    if (!decoded || !mWorkerRequest.remove(tilePos))
+    {
+        return;
+    }
+    mAttempts.remove(tilePos);
+    auto tile = new QGVImage();
+    setTileGeometry(tile, tilePos);
+    tile->loadImage(image);
+    tile->setProperty("drawDebug",
+                      QString("%1\ntile(%2,%3,%4)")
+                              .arg(source)
+                              .arg(tilePos.zoom())
+                              .arg(tilePos.pos().x())
+                              .arg(tilePos.pos().y()));
     onTile(tilePos, tile);
 }
 
+void QGVLayerTilesOnline::onWorkerMissed(const QGV::GeoTilePos& tilePos, bool decoded)
+{
+    mWorkerPrefetch.remove(tilePos);
+    if (!decoded || !mWorkerRequest.remove(tilePos))
+    {
+        return;
+    }
+    if (isOffline)
+    {
+        showOfflineTile(tilePos);
+        return;
+    }
+    // network looks unavailable, tile is requested again when it is back
+    deferTile(tilePos);
+}
+
+void QGVLayerTilesOnline::onWorkerFailed(const QGV::GeoTilePos& tilePos, int status, const QString& error, bool decoded)
+{
+    const bool prefetched = mWorkerPrefetch.remove(tilePos);
+    if (decoded && mWorkerRequest.remove(tilePos))
+    {
+        onRequestFailed(tilePos, status, error);
+        return;
+    }
+    if (!prefetched)
+    {
+        return;
+    }
+    qgvDebug() << "prefetch failed" << error;
+    if (isMissingTileStatus(status))
+    {
+        markTileMissing(tilePos);
+    }
+    else
+    {
+        incOfflineCnt(tilePos);
+    }
+}
+
+void QGVLayerTilesOnline::onPrefetchFinished(QNetworkReply* reply, const QGV::GeoTilePos& tilePos)
+{
+    // prefetch was adopted by request
+    if (mRequest.value(tilePos, nullptr) == reply)
+    {
+        onReplyFinished(reply, tilePos);
+        return;
+    }
+    onMirrorFinished(reply);
+
+    if (mPrefetch.value(tilePos, nullptr) == reply)
+    {
+        mPrefetch.remove(tilePos);
+    }
+    reply->deleteLater();
+
+    if (reply->error() != QNetworkReply::NoError)
+    {
+        qgvDebug() << "prefetch failed" << reply->errorString();
+        if (isMissingTileStatus(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()))
+        {
+            markTileMissing(tilePos);
+        }
+        else if (reply->error() != QNetworkReply::OperationCanceledError)
+        {
+            incOfflineCnt(tilePos);
+        }
+        return;
+    }
+    decOfflineCnt();
+    const auto rawImage = reply->readAll();
+
+    if (isCache)
+    {
+        mCache.putTileToCache(tilePos, tilePosToUrl(tilePos), getName(), rawImage);
+    }
+    mPrefetched.insert(tilePos, new QByteArray(rawImage), qMax(1, rawImage.size() / 1024));
+}
+
 void QGVLayerTilesOnline::removeReply(const QGV::GeoTilePos& tilePos)
 {
+    QNetworkReply* hedge = mHedge.take(tilePos);
+    if (hedge != nullptr) {
+        hedge->abort();
+        hedge->deleteLater();
+    }
     QNetworkReply* reply = mRequest.value(tilePos, nullptr);
     if (reply == nullptr) {
         return;
@@ -159,42 +583,743 @@ void QGVLayerTilesOnline::removeReply(const QGV::GeoTilePos& tilePos)
 void QGVLayerTilesOnline::setCache(bool mode)
 {
     isCache = mode;
-    offline_counter = 0;
+    clearOfflineCnt();
 }
 
 void QGVLayerTilesOnline::setOffline(bool mode)
 {
+    const bool wasOffline = isOfflineActive();
     isOffline = mode;
-    offline_counter = 0;
+    clearOfflineCnt();
+    mAutoOfflineActive = false;
+    updateProbeTimer();
+    if (wasOffline != isOfflineActive())
+    {
+        Q_EMIT offlineChanged(isOfflineActive());
+    }
 }
 
-void QGVLayerTilesOnline::incOfflineCnt()
+/*!
+ * Failed request (network error, server error, timeout or throttling) is repeated with exponential backoff.
+ */
+void QGVLayerTilesOnline::setMaxRetries(int value)
 {
-    offline_counter++;
-    if (offline_counter > offline_cnt_max)
+    mMaxRetries = qMax(0, value);
+    qgvDebug() << "MaxRetries changed to" << mMaxRetries;
+}
+
+/*!
+ * Layer switches to cache-only mode by itself after series of failed requests and goes back online
+ * when periodic probe request succeeds.
+ */
+void QGVLayerTilesOnline::setAutoOffline(bool enabled)
+{
+    mAutoOfflineEnabled = enabled;
+    qgvDebug() << "AutoOffline changed to" << enabled;
+    if (!enabled && mAutoOfflineActive)
     {
-        offline_counter = 0;
+        clearOfflineCnt();
+        setAutoOfflineState(false);
+        requestDeferred();
     }
 }
 
-int QGVLayerTilesOnline::loadTilesFromGeo(QGV::GeoRect areaGeoRect, int zoom)
+bool QGVLayerTilesOnline::isOfflineActive() const
 {
-    const QPoint topLeft = QGV::GeoTilePos::geoToTilePos(zoom, areaGeoRect.topLeft()).pos();
-    const QPoint bottomRight = QGV::GeoTilePos::geoToTilePos(zoom, areaGeoRect.bottomRight()).pos();
-    QRect activeRect = QRect(topLeft, bottomRight);
+    return isOffline || mAutoOfflineActive;
+}
+
+/*!
+ * Tiles are fetched, cached and decoded by worker thread with its own network manager,
+ * so reply handling and cache writes of busy layer don't compete with painting.
+ * Hedging and memory prefetch are not used in this mode, prefetched tiles are put to cache.
+ */
+void QGVLayerTilesOnline::setNetworkThread(bool enabled)
+{
+    if (enabled == (mWorker != nullptr))
+    {
+        return;
+    }
+    qgvDebug() << "NetworkThread changed to" << enabled;
+    if (enabled)
+    {
+        qRegisterMetaType<QGV::GeoTilePos>();
+        mWorkerThread = new QThread(this);
+        mWorker = new QGVLayerTilesOnlineWorker();
+        mWorker->moveToThread(mWorkerThread);
+        connect(mWorkerThread, &QThread::finished, mWorker, &QObject::deleteLater);
+        updateWorkerNetwork();
+        connect(mWorker, &QGVLayerTilesOnlineWorker::tileLoaded, this, &QGVLayerTilesOnline::onWorkerLoaded);
+        connect(mWorker, &QGVLayerTilesOnlineWorker::tileMissed, this, &QGVLayerTilesOnline::onWorkerMissed);
+        connect(mWorker, &QGVLayerTilesOnlineWorker::tileFailed, this, &QGVLayerTilesOnline::onWorkerFailed);
+        connect(mWorker, &QGVLayerTilesOnlineWorker::mirrorFinished, this, [this](int mirror, bool failed, qint64 latency) {
+            updateMirrorHealth(mirror, failed, latency);
+            if (!failed)
+            {
+                decOfflineCnt();
+            }
+        });
+        mWorkerThread->start();
+        return;
+    }
+    stopWorker();
 
-    qgvDebug() << "loadTilesFromGeo: rect" << activeRect.topLeft() << activeRect.bottomRight();
+    // pending tiles are requested again by layer itself
+    const QSet<QGV::GeoTilePos> pending = mWorkerRequest;
+    mWorkerRequest.clear();
+    mWorkerPrefetch.clear();
+    for (const QGV::GeoTilePos& tilePos : pending)
+    {
+        request(tilePos);
+    }
+}
 
-    for (int x = activeRect.left(); x < activeRect.right(); ++x)
+/*!
+ * Worker uses its own manager with proxy and disk cache of layer manager.
+ */
+void QGVLayerTilesOnline::updateWorkerNetwork()
+{
+    QNetworkAccessManager* manager = getNetworkManager();
+    if (mWorker == nullptr || manager == nullptr)
     {
-        for (int y = activeRect.top(); y < activeRect.bottom(); ++y)
+        return;
+    }
+    const QNetworkProxy proxy = manager->proxy();
+    QString cacheDirectory;
+    qint64 cacheSize = 0;
+    auto diskCache = qobject_cast<QNetworkDiskCache*>(manager->cache());
+    if (diskCache != nullptr)
+    {
+        cacheDirectory = diskCache->cacheDirectory();
+        cacheSize = diskCache->maximumCacheSize();
+    }
+    QGVLayerTilesOnlineWorker* worker = mWorker;
+    QMetaObject::invokeMethod(
+            worker,
+            [worker, proxy, cacheDirectory, cacheSize]() { worker->setNetworkSettings(proxy, cacheDirectory, cacheSize); },
+            Qt::QueuedConnection);
+}
+
+void QGVLayerTilesOnline::stopWorker()
+{
+    if (mWorkerThread == nullptr)
+    {
+        return;
+    }
+    // worker is deleted in its thread together with its replies and cache connection
+    mWorkerThread->quit();
+    mWorkerThread->wait();
+    delete mWorkerThread;
+    mWorkerThread = nullptr;
+    mWorker = nullptr;
+}
+
+bool QGVLayerTilesOnline::isNetworkThread() const
+{
+    return mWorker != nullptr;
+}
+
+/*!
+ * Layer specific network manager, nullptr means global one from QGV::getNetworkManager().
+ * Manager is not owned by layer.
+ */
+void QGVLayerTilesOnline::setNetworkManager(QNetworkAccessManager* manager)
+{
+    switchNetworkManager(manager, false);
+}
+
+/*!
+ * Layer creates its own network manager, so its connections are not shared with other layers
+ * and heavy layer does not delay requests of lighter ones.
+ */
+void QGVLayerTilesOnline::setDedicatedNetworkManager(bool enabled)
+{
+    qgvDebug() << "DedicatedNetworkManager changed to" << enabled;
+    if (enabled == mDedicatedNetworkManager)
+    {
+        return;
+    }
+    if (!enabled)
+    {
+        setNetworkManager(nullptr);
+        return;
+    }
+    auto manager = new QNetworkAccessManager(this);
+    copyNetworkSettings(QGV::getNetworkManager(), manager);
+    switchNetworkManager(manager, true);
+}
+
+/*!
+ * Replies of previous manager are aborted and their tiles are requested again by new one,
+ * so no reply is left in flight when dedicated manager is deleted.
+ */
+void QGVLayerTilesOnline::switchNetworkManager(QNetworkAccessManager* manager, bool dedicated)
+{
+    QNetworkAccessManager* previous = (mDedicatedNetworkManager) ? mNetworkManager.data() : nullptr;
+    const QList<QGV::GeoTilePos> pending = mRequest.keys();
+    const QList<QNetworkReply*> replies = mRequest.values() + mHedge.values() + mPrefetch.values();
+    mRequest.clear();
+    mHedge.clear();
+    mPrefetch.clear();
+    mNetworkManager = manager;
+    mDedicatedNetworkManager = dedicated;
+
+    for (QNetworkReply* reply : replies)
+    {
+        reply->abort();
+        reply->deleteLater();
+    }
+    if (previous != nullptr)
+    {
+        // download jobs put aborted tiles back to their queues and continue with new manager
+        for (QNetworkReply* reply : previous->findChildren<QNetworkReply*>())
         {
-            const auto tilePos = QGV::GeoTilePos(zoom, QPoint(x, y));
-            qgvDebug() << "loadTilesFromGeo: tilePos " << tilePos.pos().x() << tilePos.pos().y();
-            request(tilePos);
+            reply->abort();
         }
+        previous->deleteLater();
+    }
+    updateWorkerNetwork();
+    for (const QGV::GeoTilePos& tilePos : pending)
+    {
+        request(tilePos);
+    }
+}
+
+QNetworkAccessManager* QGVLayerTilesOnline::getNetworkManager() const
+{
+    return (mNetworkManager != nullptr) ? mNetworkManager.data() : QGV::getNetworkManager();
+}
+
+void QGVLayerTilesOnline::setHttp2(bool enabled)
+{
+    mHttp2 = enabled;
+    qgvDebug() << "Http2 changed to" << enabled;
+}
+
+/*!
+ * Limit of parallel HTTP/1.1 connections to one host, zero keeps Qt default (6).
+ * Supported since Qt 6.5.
+ */
+void QGVLayerTilesOnline::setConnectionsPerHost(int value)
+{
+    mConnectionsPerHost = qMax(0, value);
+    qgvDebug() << "ConnectionsPerHost changed to" << mConnectionsPerHost;
+}
+
+/*!
+ * Time to keep idle connection open, zero keeps Qt default.
+ * Supported since Qt 6.3.
+ */
+void QGVLayerTilesOnline::setKeepAliveTimeout(int seconds)
+{
+    mKeepAliveTimeout = qMax(0, seconds);
+    qgvDebug() << "KeepAliveTimeout changed to" << mKeepAliveTimeout;
+}
+
+void QGVLayerTilesOnline::setUserAgent(const QByteArray& userAgent)
+{
+    mUserAgent = userAgent.isEmpty() ? QByteArray(defaultUserAgent) : userAgent;
+    qgvDebug() << "UserAgent changed to" << mUserAgent;
+}
+
+/*!
+ * Requests are spread over mirrors of tiles server. Disabled by default.
+ */
+void QGVLayerTilesOnline::setMirrorsEnabled(bool enabled)
+{
+    mMirrorsEnabled = enabled;
+    qgvDebug() << "MirrorsEnabled changed to" << enabled;
+}
+
+/*!
+ * Visible tile request which is slower than given percentile of recent latencies is duplicated to another mirror.
+ * Zero disables hedging (default), mirrors must be enabled too.
+ */
+void QGVLayerTilesOnline::setHedgePercentile(double percentile)
+{
+    mHedgePercentile = qBound(0.0, percentile, 1.0);
+    qgvDebug() << "HedgePercentile changed to" << mHedgePercentile;
+}
+
+int QGVLayerTilesOnline::mirrorsCount() const
+{
+    return 1;
+}
+
+QString QGVLayerTilesOnline::tilePosToMirrorUrl(const QGV::GeoTilePos& tilePos, int /*mirror*/) const
+{
+    return tilePosToUrl(tilePos);
+}
+
+QNetworkReply* QGVLayerTilesOnline::sendTileRequest(const QGV::GeoTilePos& tilePos,
+                                                    QNetworkRequest::Priority priority,
+                                                    int excludeMirror)
+{
+    const int mirror = selectMirror(excludeMirror);
+    QNetworkReply* reply = sendRequest(QUrl(tilePosToMirrorUrl(tilePos, mirror)), priority);
+    reply->setProperty(mirrorProperty, mirror);
+    reply->setProperty(startedProperty, mClock.elapsed());
+    return reply;
+}
+
+/*!
+ * Round-robin over mirrors, skipping hosts with high error rate or latency much higher than the best one.
+ * Skipped host is probed from time to time, so it can recover.
+ */
+int QGVLayerTilesOnline::selectMirror(int excludeMirror)
+{
+    const int count = (mMirrorsEnabled) ? qMax(1, mirrorsCount()) : 1;
+    if (mMirrors.size() != count)
+    {
+        mMirrors.resize(count);
+        mNextMirror = 0;
+    }
+    if (count == 1)
+    {
+        return 0;
     }
 
+    auto median = [this](int mirror) { return percentileOf(mMirrors[mirror].latencyMs, 0.5); };
+    qint64 best = std::numeric_limits<qint64>::max();
+    for (int mirror = 0; mirror < count; ++mirror)
+    {
+        const MirrorHealth& health = mMirrors[mirror];
+        if (mirror != excludeMirror && health.errorRate < mirrorErrorLimit && !health.latencyMs.isEmpty())
+        {
+            best = qMin(best, median(mirror));
+        }
+    }
 
-    return 0;
+    int fallback = -1;
+    for (int step = 0; step < count; ++step)
+    {
+        const int mirror = (mNextMirror + step) % count;
+        if (mirror == excludeMirror)
+        {
+            continue;
+        }
+        MirrorHealth& health = mMirrors[mirror];
+        const bool healthy = health.errorRate < mirrorErrorLimit;
+        const bool fast = health.latencyMs.isEmpty() || best == std::numeric_limits<qint64>::max() ||
+                          median(mirror) <= static_cast<qint64>(best * mirrorSlowFactor) + mirrorSlowSlackMs;
+        if ((healthy && fast) || health.skipped >= mirrorProbeInterval)
+        {
+            health.skipped = 0;
+            mNextMirror = (mirror + 1) % count;
+            return mirror;
+        }
+        health.skipped++;
+        if (fallback < 0 || health.errorRate < mMirrors[fallback].errorRate)
+        {
+            fallback = mirror;
+        }
+    }
+    return qMax(0, fallback);
+}
+
+void QGVLayerTilesOnline::onMirrorFinished(QNetworkReply* reply)
+{
+    const QVariant mirrorValue = reply->property(mirrorProperty);
+    if (!mirrorValue.isValid())
+    {
+        return;
+    }
+    // statistics are collected once per reply
+    reply->setProperty(mirrorProperty, QVariant());
+    const int mirror = mirrorValue.toInt();
+    if (mirror >= mMirrors.size() || reply->error() == QNetworkReply::OperationCanceledError)
+    {
+        return;
+    }
+    const bool failed = (reply->error() != QNetworkReply::NoError);
+    const qint64 latency = mClock.elapsed() - reply->property(startedProperty).toLongLong();
+    QGVMetrics* metrics = QGVMetrics::instance();
+    if (metrics->isEnabled())
+    {
+        metrics->record(QGVMetrics::Stage::Network, metrics->nowUs() - latency * 1000, latency * 1000);
+    }
+    updateMirrorHealth(mirror, failed, latency);
+}
+
+void QGVLayerTilesOnline::updateMirrorHealth(int mirror, bool failed, qint64 latency)
+{
+    if (mirror < 0 || mirror >= mMirrors.size())
+    {
+        return;
+    }
+    MirrorHealth& health = mMirrors[mirror];
+    health.errorRate = health.errorRate * (1.0 - mirrorErrorWeight) + (failed ? mirrorErrorWeight : 0.0);
+    if (failed)
+    {
+        return;
+    }
+    if (health.latencyMs.size() < mirrorLatencySamples)
+    {
+        health.latencyMs.append(latency);
+    }
+    else
+    {
+        health.latencyMs[health.latencyPos] = latency;
+        health.latencyPos = (health.latencyPos + 1) % mirrorLatencySamples;
+    }
+}
+
+qint64 QGVLayerTilesOnline::hedgeDelayMs() const
+{
+    if (!mMirrorsEnabled || mHedgePercentile <= 0.0 || mMirrors.size() < 2)
+    {
+        return -1;
+    }
+    QVector<qint64> samples;
+    for (const MirrorHealth& health : mMirrors)
+    {
+        samples += health.latencyMs;
+    }
+    if (samples.size() < hedgeMinSamples)
+    {
+        return -1;
+    }
+    return qMax(hedgeMinDelayMs, percentileOf(samples, mHedgePercentile));
+}
+
+void QGVLayerTilesOnline::scheduleHedge(const QGV::GeoTilePos& tilePos, QNetworkReply* reply)
+{
+    const qint64 delay = hedgeDelayMs();
+    if (delay < 0)
+    {
+        return;
+    }
+    // timer is bound to reply, so it is dropped together with reply
+    QTimer::singleShot(static_cast<int>(delay), reply, [this, tilePos, reply]() { hedgeRequest(tilePos, reply); });
+}
+
+void QGVLayerTilesOnline::hedgeRequest(const QGV::GeoTilePos& tilePos, QNetworkReply* reply)
+{
+    if (mRequest.value(tilePos, nullptr) != reply || mHedge.contains(tilePos) || reply->isFinished())
+    {
+        return;
+    }
+    const QVariant mirrorValue = reply->property(mirrorProperty);
+    const int excludeMirror = mirrorValue.isValid() ? mirrorValue.toInt() : -1;
+    QNetworkReply* hedge = sendTileRequest(tilePos, QNetworkRequest::HighPriority, excludeMirror);
+    mHedge[tilePos] = hedge;
+    connect(hedge, &QNetworkReply::finished, hedge, [this, hedge, tilePos]() { onReplyFinished(hedge, tilePos); });
+    qgvDebug() << "hedge" << reply->url() << "by" << hedge->url();
+}
+
+void QGVLayerTilesOnline::onRequestFailed(const QGV::GeoTilePos& tilePos, int status, const QString& error)
+{
+    QGVMetrics::instance()->add(QGVMetrics::Counter::TilesFailed);
+    if (isMissingTileStatus(status))
+    {
+        // retries won't help, remember that tile is missing
+        qgvWarning() << "tile is missing" << error;
+        mAttempts.remove(tilePos);
+        markTileMissing(tilePos);
+        showMissingTile(tilePos);
+        return;
+    }
+    incOfflineCnt(tilePos);
+
+    const int attempt = mAttempts.value(tilePos, 0) + 1;
+    if (attempt > mMaxRetries)
+    {
+        qgvCritical() << "ERROR" << error;
+        // tile is requested again when network is back
+        mAttempts.remove(tilePos);
+        deferTile(tilePos);
+        return;
+    }
+    mAttempts[tilePos] = attempt;
+    const int delay = retryDelayMs << (attempt - 1);
+    qgvDebug() << "retry" << attempt << "in" << delay << "ms" << error;
+    QTimer::singleShot(delay, this, [this, tilePos, attempt]() { retryRequest(tilePos, attempt); });
+}
+
+void QGVLayerTilesOnline::retryRequest(const QGV::GeoTilePos& tilePos, int attempt)
+{
+    // tile was cancelled or requested again meanwhile
+    if (mAttempts.value(tilePos, 0) != attempt || mRequest.contains(tilePos) || mWorkerRequest.contains(tilePos))
+    {
+        return;
+    }
+    request(tilePos);
+}
+
+bool QGVLayerTilesOnline::isTileMissing(const QGV::GeoTilePos& tilePos)
+{
+    const qint64* expire = mMissing.object(tilePos);
+    if (expire == nullptr)
+    {
+        return false;
+    }
+    if (*expire > mClock.elapsed())
+    {
+        return true;
+    }
+    mMissing.remove(tilePos);
+    return false;
+}
+
+/*!
+ * Negative cache is bounded, least recently used records are dropped first.
+ */
+void QGVLayerTilesOnline::markTileMissing(const QGV::GeoTilePos& tilePos)
+{
+    mMissing.insert(tilePos, new qint64(mClock.elapsed() + missingTileExpireMs));
+}
+
+void QGVLayerTilesOnline::deferTile(const QGV::GeoTilePos& tilePos)
+{
+    mDeferred.insert(tilePos);
+    updateProbeTimer();
+}
+
+void QGVLayerTilesOnline::showOfflineTile(const QGV::GeoTilePos& tilePos)
+{
+    // offline mode, try to show deepest cached tile below first
+    QGVDrawItem* fallback = overzoom(tilePos);
+    if (fallback != nullptr)
+    {
+        onTile(tilePos, fallback);
+        return;
+    }
+
+    auto tile_rect = new QGVImage();
+    tile_rect->setProperty("drawDebug",
+                           QString("%1\ntile(%2,%3,%4)")
+                                   .arg(tilePosToUrl(tilePos))
+                                   .arg(tilePos.zoom())
+                                   .arg(tilePos.pos().x())
+                                   .arg(tilePos.pos().y()));
+
+    // offline mode
+    setTileGeometry(tile_rect, tilePos);
+    tile_rect->loadImage(mCache.getNoData("NO DATA"));
+
+    onTile(tilePos, tile_rect);
+}
+
+void QGVLayerTilesOnline::showMissingTile(const QGV::GeoTilePos& tilePos)
+{
+    // deepest cached tile below is better than nothing
+    QGVDrawItem* fallback = overzoom(tilePos);
+    if (fallback != nullptr)
+    {
+        onTile(tilePos, fallback);
+        return;
+    }
+    auto tile = new QGVImage();
+    setTileGeometry(tile, tilePos);
+    tile->setProperty("drawDebug",
+                      QString("missing\ntile(%1,%2,%3)")
+                              .arg(tilePos.zoom())
+                              .arg(tilePos.pos().x())
+                              .arg(tilePos.pos().y()));
+    onTile(tilePos, tile);
+}
+
+bool QGVLayerTilesOnline::isProbeDue() const
+{
+    return mProbeDue;
+}
+
+void QGVLayerTilesOnline::consumeProbe()
+{
+    mProbeDue = false;
+}
+
+/*!
+ * Probe timer runs while network is unavailable or some tiles wait for it, so they are requested
+ * again even when camera doesn't move.
+ */
+void QGVLayerTilesOnline::updateProbeTimer()
+{
+    const bool needed = !isOffline && (mAutoOfflineActive || !mDeferred.isEmpty());
+    if (needed && !mProbeTimer.isActive())
+    {
+        mProbeTimer.start();
+    }
+    else if (!needed)
+    {
+        mProbeTimer.stop();
+    }
+}
+
+void QGVLayerTilesOnline::onProbeTimer()
+{
+    mProbeDue = true;
+    if (!mDeferred.isEmpty())
+    {
+        // one tile is enough to find out if network is back
+        const QGV::GeoTilePos tilePos = *mDeferred.begin();
+        mDeferred.remove(tilePos);
+        updateProbeTimer();
+        request(tilePos);
+        return;
+    }
+    if (!mAutoOfflineActive || mProbeTile.zoom() < 0 || getNetworkManager() == nullptr)
+    {
+        return;
+    }
+    // all visible tiles are served from cache, so last failed tile is probed
+    consumeProbe();
+    qgvDebug() << "probe" << mProbeTile;
+    QNetworkReply* reply = sendTileRequest(mProbeTile, QNetworkRequest::LowPriority);
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { onProbeFinished(reply); });
+}
+
+void QGVLayerTilesOnline::onProbeFinished(QNetworkReply* reply)
+{
+    onMirrorFinished(reply);
+    reply->deleteLater();
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    // any answer of server means that network is available
+    if (reply->error() == QNetworkReply::NoError || isMissingTileStatus(status))
+    {
+        decOfflineCnt();
+    }
+}
+
+/*!
+ * Failures are counted over sliding window of last offline_cnt_max requests, so sporadic
+ * successes on a broken network don't keep layer online.
+ */
+void QGVLayerTilesOnline::incOfflineCnt(const QGV::GeoTilePos& tilePos)
+{
+    mProbeTile = tilePos;
+    if (mAutoOfflineActive)
+    {
+        return;
+    }
+    addOfflineSample(true);
+    const bool full = (mOfflineWindow.size() >= offline_cnt_max);
+    if (mAutoOfflineEnabled && !isOffline && full && offline_counter >= offlineErrorLimit * offline_cnt_max)
+    {
+        setAutoOfflineState(true);
+    }
+}
+
+void QGVLayerTilesOnline::decOfflineCnt()
+{
+    if (mAutoOfflineActive)
+    {
+        // successful probe, network is back
+        clearOfflineCnt();
+        setAutoOfflineState(false);
+        requestDeferred();
+        return;
+    }
+    addOfflineSample(false);
+    // deferred tiles after exhausted retries are requested again once per probe interval
+    if (isProbeDue())
+    {
+        requestDeferred();
+    }
+}
+
+void QGVLayerTilesOnline::addOfflineSample(bool failed)
+{
+    if (mOfflineWindow.size() < offline_cnt_max)
+    {
+        mOfflineWindow.append(failed);
+    }
+    else
+    {
+        offline_counter -= mOfflineWindow[mOfflineWindowPos] ? 1 : 0;
+        mOfflineWindow[mOfflineWindowPos] = failed;
+        mOfflineWindowPos = (mOfflineWindowPos + 1) % offline_cnt_max;
+    }
+    offline_counter += failed ? 1 : 0;
+}
+
+void QGVLayerTilesOnline::clearOfflineCnt()
+{
+    mOfflineWindow.clear();
+    mOfflineWindowPos = 0;
+    offline_counter = 0;
+}
+
+void QGVLayerTilesOnline::requestDeferred()
+{
+    if (mDeferred.isEmpty())
+    {
+        return;
+    }
+    consumeProbe();
+    const QSet<QGV::GeoTilePos> deferred = mDeferred;
+    mDeferred.clear();
+    updateProbeTimer();
+    for (const QGV::GeoTilePos& tilePos : deferred)
+    {
+        request(tilePos);
+    }
+}
+
+void QGVLayerTilesOnline::setAutoOfflineState(bool offline)
+{
+    if (mAutoOfflineActive == offline)
+    {
+        return;
+    }
+    mAutoOfflineActive = offline;
+    consumeProbe();
+    updateProbeTimer();
+    if (offline)
+    {
+        qgvWarning() << "network is unavailable, tiles are served from cache";
+    }
+    else
+    {
+        qgvDebug() << "network is available again";
+    }
+    Q_EMIT offlineChanged(isOfflineActive());
+}
+
+int QGVLayerTilesOnline::countRequestsInFlight() const
+{
+    return mRequest.size() + mHedge.size() + mPrefetch.size() + mWorkerRequest.size() + mWorkerPrefetch.size();
+}
+
+/*!
+ * Low priority request of tile for download jobs, reply is owned by caller.
+ * Health of mirror is updated when reply is finished.
+ */
+QNetworkReply* QGVLayerTilesOnline::downloadTile(const QGV::GeoTilePos& tilePos)
+{
+    QNetworkReply* reply = sendTileRequest(tilePos, QNetworkRequest::LowPriority);
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { onMirrorFinished(reply); });
+    return reply;
+}
+
+/*!
+ * Ids of cached tiles of given zoom level which are descendants of root.
+ */
+QSet<QGV::GeoTileId> QGVLayerTilesOnline::cachedTileIds(const QGV::GeoTilePos& root, int zoom)
+{
+    return mCache.cachedTileIds(root, zoom, getName());
+}
+
+/*!
+ * Tiles are written to cache in one transaction.
+ */
+void QGVLayerTilesOnline::storeTiles(const QList<QPair<QGV::GeoTilePos, QByteArray>>& tiles)
+{
+    mCache.beginTransaction();
+    for (const auto& tile : tiles)
+    {
+        mCache.putTileToCache(tile.first, tilePosToUrl(tile.first), getName(), tile.second);
+    }
+    mCache.commitTransaction();
+}
+
+int QGVLayerTilesOnline::loadTilesFromGeo(QGV::GeoRect areaGeoRect, int zoom)
+{
+    auto job = new QGVLayerTilesOnlineDownload(this, this);
+    connect(job, &QGVLayerTilesOnlineDownload::finished, job, &QObject::deleteLater);
+    job->setArea(areaGeoRect, zoom, zoom);
+    const int count = static_cast<int>(job->estimateTiles());
+    qgvDebug() << "loadTilesFromGeo: tiles" << count;
+    job->start();
+    return count;
 }
@@ -38,6 +38,8 @@ void QGVLayerTilesOnlineCache::init_cache()
     else
     {
         qgvDebug() << "Open database successfully\n";
+        // database is shared by connections of several layers and worker threads
+        sqlite3_busy_timeout(mDb, 5000);
         createCache2Db();
     }
 }
@@ -61,6 +63,11 @@ QString QGVLayerTilesOnlineCache::parseUrl2fileName(QString url)
     return temp_str;
 }
 
+bool QGVLayerTilesOnlineCache::hasTileInCache(QString tile_name)
+{
+    return QFile::exists(QString(cache_dir) + parseUrl2fileName(tile_name));
+}
+
 QByteArray QGVLayerTilesOnlineCache::getTileFromCache(const QGV::GeoTilePos& tilePos, QString tile_name, QString prv_name)
 {
     QString fname = parseUrl2fileName(tile_name);
@@ -95,7 +102,7 @@ QByteArray QGVLayerTilesOnlineCache::getTileFromCache(const QGV::GeoTilePos& til
     return rawImage;
 }
 
-bool QGVLayerTilesOnlineCache::putTileToCache(const QGV::GeoTilePos& tilePos, QString tile_name, QString prv_name, QByteArray raw_tile)
+bool QGVLayerTilesOnlineCache::putTileToCache(const QGV::GeoTilePos& tilePos, QString tile_name, QString prv_name, const QByteArray& raw_tile)
 {
     // save to file
     QString fname = parseUrl2fileName(tile_name);
@@ -115,6 +122,27 @@ bool QGVLayerTilesOnlineCache::putTileToCache(const QGV::GeoTilePos& tilePos, QS
     return false;
 }
 
+void QGVLayerTilesOnlineCache::beginTransaction()
+{
+    // nested calls are merged into the outermost transaction
+    if (transaction_depth++ == 0)
+    {
+        execSql("BEGIN TRANSACTION;");
+    }
+}
+
+void QGVLayerTilesOnlineCache::commitTransaction()
+{
+    if (transaction_depth == 0)
+    {
+        return;
+    }
+    if (--transaction_depth == 0)
+    {
+        execSql("COMMIT;");
+    }
+}
+
 QImage QGVLayerTilesOnlineCache::getNoData(QString _text)
 {
     // draw
@@ -154,6 +182,10 @@ bool QGVLayerTilesOnlineCache::createCache2Db()
                 qgvDebug() << "createCache2Db: create error";
                 sqlite3_free(zErrMsg);
             }
+            else
+            {
+                migrateCache2Db();
+            }
         }
         else
         {
@@ -168,6 +200,106 @@ bool QGVLayerTilesOnlineCache::createCache2Db()
 
     return false;
 }
+
+void QGVLayerTilesOnlineCache::migrateCache2Db()
+{
+    // tiles from table of previous versions (keyed by x, y, zoom) are moved to table keyed by tile id
+    sqlite3_stmt *old_stmt;
+    if (sqlite3_prepare_v2(mDb, cache_old, -1, &old_stmt, NULL) != SQLITE_OK)
+    {
+        // no table of previous version
+        return;
+    }
+
+    sqlite3_stmt *ins_stmt;
+    if (sqlite3_prepare_v2(mDb, cache_migrate, -1, &ins_stmt, NULL) != SQLITE_OK)
+    {
+        qgvDebug() << "migrateCache2Db: prepare error " << sqlite3_errmsg(mDb);
+        sqlite3_finalize(old_stmt);
+        return;
+    }
+
+    int count = 0;
+    beginTransaction();
+    while (sqlite3_step(old_stmt) == SQLITE_ROW)
+    {
+        const int x = sqlite3_column_int(old_stmt, 1);
+        const int y = sqlite3_column_int(old_stmt, 2);
+        const int zoom = sqlite3_column_int(old_stmt, 3);
+        const QGV::GeoTilePos tilePos(zoom, QPoint(x, y));
+
+        sqlite3_bind_value(ins_stmt, 1, sqlite3_column_value(old_stmt, 0));
+        sqlite3_bind_int64(ins_stmt, 2, static_cast<sqlite3_int64>(tilePos.toId()));
+        sqlite3_bind_int(ins_stmt, 3, x);
+        sqlite3_bind_int(ins_stmt, 4, y);
+        sqlite3_bind_int(ins_stmt, 5, zoom);
+        for (int col = 4; col < 9; ++col)
+        {
+            sqlite3_bind_value(ins_stmt, col + 2, sqlite3_column_value(old_stmt, col));
+        }
+        if (sqlite3_step(ins_stmt) != SQLITE_DONE)
+        {
+            qgvDebug() << "migrateCache2Db: insert error " << sqlite3_errmsg(mDb);
+        }
+        sqlite3_reset(ins_stmt);
+        count++;
+    }
+    sqlite3_finalize(ins_stmt);
+    sqlite3_finalize(old_stmt);
+    execSql(cache_drop_old);
+    commitTransaction();
+
+    qgvDebug() << "migrateCache2Db: migrated tiles " << count;
+}
+
+QSet<QGV::GeoTileId> QGVLayerTilesOnlineCache::cachedTileIds(const QGV::GeoTilePos& root, int zoom, QString prv_name)
+{
+    QSet<QGV::GeoTileId> ids;
+    sqlite3_stmt *stmt;
+
+    if (mret)
+    {
+        qgvDebug() << "cachedTileIds: db connection not initialized!";
+        return ids;
+    }
+
+    // all cached descendants of root tile are selected by one range of ids
+    const std::string str = QString(cache_sel_ids).arg(prv_name).arg(zoom).arg(root.toId()).arg(root.descendantsIdEnd()).toStdString();
+    if (sqlite3_prepare_v2(mDb, str.c_str(), -1, &stmt, NULL) != SQLITE_OK)
+    {
+        qgvDebug() << "cachedTileIds: select error " << sqlite3_errmsg(mDb);
+        return ids;
+    }
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        ids.insert(static_cast<QGV::GeoTileId>(sqlite3_column_int64(stmt, 0)));
+    }
+    sqlite3_finalize(stmt);
+
+    return ids;
+}
+
+bool QGVLayerTilesOnlineCache::execSql(const char* sql)
+{
+    char *zErrMsg = 0;
+
+    if (mret)
+    {
+        qgvDebug() << "execSql: db connection not initialized!";
+        return false;
+    }
+
+    int rc = sqlite3_exec(mDb, sql, NULL, 0, &zErrMsg);
+    if (rc != SQLITE_OK)
+    {
+        qgvDebug() << "execSql: error " << QString::fromLocal8Bit(zErrMsg);
+        sqlite3_free(zErrMsg);
+        return false;
+    }
+
+    return true;
+}
+
 int QGVLayerTilesOnlineCache::insertTile2Db(const QGV::GeoTilePos& tilePos, QString tile_fname, QString prv_name, int fsize)
 {
     const char *pSQL;
@@ -176,7 +308,7 @@ int QGVLayerTilesOnlineCache::insertTile2Db(const QGV::GeoTilePos& tilePos, QStr
 
     if (!mret)
     {
-        QString ins_str = QString(cache_insert).arg(prv_name).arg(tilePos.pos().x()).arg(tilePos.pos().y()).arg(tilePos.zoom()).arg(tile_fname).arg(fsize);
+        QString ins_str = QString(cache_insert).arg(prv_name).arg(tilePos.toId()).arg(tilePos.pos().x()).arg(tilePos.pos().y()).arg(tilePos.zoom()).arg(tile_fname).arg(fsize);
 
         std::string str = ins_str.toStdString();
         qgvDebug() << "insertTile2Db: " << ins_str;
@@ -214,8 +346,8 @@ QString QGVLayerTilesOnlineCache::getTileFromDb(const QGV::GeoTilePos& tilePos,
 
     if (!mret)
     {
-        //select t_x,t_y,t_zoom,t_name,t_datetime,t_datetime_u from tiles_cache where t_scheme = '%1' and t_x = %2 and t_y = %3 and t_zoom = %4;
-        QString sel_str = QString(cache_sel).arg(prv_name).arg(tilePos.pos().x()).arg(tilePos.pos().y()).arg(tilePos.zoom());
+        //select t_x,t_y,t_zoom,t_name,t_datetime,t_datetime_u from tiles where t_scheme = '%1' and t_id = %2;
+        QString sel_str = QString(cache_sel).arg(prv_name).arg(tilePos.toId());
 
         std::string str = sel_str.toStdString();
         qgvDebug() << "getTileFromDb: " << sel_str;
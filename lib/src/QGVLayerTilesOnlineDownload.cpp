@@ -0,0 +1,350 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "QGVLayerTilesOnlineDownload.h"
+
+#include <QTimer>
+
+#include <cmath>
+
+namespace {
+const int retryDelayMs = 1000;
+
+// area crossing antimeridian is split into parts within [-180, 180]
+QVector<QGV::GeoRect> splitArea(const QGV::GeoRect& area)
+{
+    if (area.isEmpty()) {
+        return {};
+    }
+    if (area.lonRigth() - area.lonLeft() >= 360.0) {
+        return { QGV::GeoRect(area.latTop(), -180.0, area.latBottom(), 180.0) };
+    }
+    const double shift = 360.0 * std::floor((area.lonLeft() + 180.0) / 360.0);
+    const double west = area.lonLeft() - shift;
+    const double east = area.lonRigth() - shift;
+    if (east <= 180.0) {
+        return { QGV::GeoRect(area.latTop(), west, area.latBottom(), east) };
+    }
+    return QGV::GeoRect::fromWestEast(area.latTop(), west, area.latBottom(), east - 360.0);
+}
+}
+
+QGVLayerTilesOnlineDownload::QGVLayerTilesOnlineDownload(QGVLayerTilesOnline* layer, QObject* parent)
+    : QObject(parent)
+    , mLayer(layer)
+    , mFromZoom(0)
+    , mToZoom(-1)
+    , mMaxParallel(4)
+    , mMaxRetries(3)
+    , mBatchSize(100)
+    , mAverageTileBytes(20 * 1024)
+    , mRunning(false)
+    , mCurZoom(0)
+    , mCurIndex(0)
+    , mScheduledRetries(0)
+    , mCachedZoom(-1)
+    , mProcessed(0)
+    , mFailed(0)
+    , mDownloaded(0)
+    , mDownloadedBytes(0)
+{
+    Q_ASSERT(layer);
+    connect(layer, &QGVLayerTilesOnline::offlineChanged, this, &QGVLayerTilesOnlineDownload::onOfflineChanged);
+}
+
+QGVLayerTilesOnlineDownload::~QGVLayerTilesOnlineDownload()
+{
+    stop();
+}
+
+void QGVLayerTilesOnlineDownload::setArea(const QGV::GeoRect& areaGeoRect, int fromZoom, int toZoom)
+{
+    stop();
+    mArea = areaGeoRect;
+    mAreaParts = splitArea(areaGeoRect);
+    mFromZoom = fromZoom;
+    mToZoom = toZoom;
+    mCurZoom = fromZoom;
+    mCurIndex = 0;
+    mCachedZoom = -1;
+    mRetry.clear();
+    mProcessed = 0;
+    mFailed = 0;
+    qgvDebug() << "download area" << mArea << "zoom" << mFromZoom << mToZoom << "tiles" << estimateTiles();
+}
+
+void QGVLayerTilesOnlineDownload::setMaxParallel(int value)
+{
+    mMaxParallel = qMax(1, value);
+    fill();
+}
+
+void QGVLayerTilesOnlineDownload::setMaxRetries(int value)
+{
+    mMaxRetries = qMax(0, value);
+}
+
+void QGVLayerTilesOnlineDownload::setBatchSize(int value)
+{
+    mBatchSize = qMax(1, value);
+}
+
+void QGVLayerTilesOnlineDownload::setAverageTileBytes(qint64 value)
+{
+    mAverageTileBytes = value;
+}
+
+qint64 QGVLayerTilesOnlineDownload::estimateTiles() const
+{
+    qint64 count = 0;
+    for (int zoom = mFromZoom; zoom <= mToZoom; ++zoom) {
+        for (const QRect& rect : zoomRects(zoom)) {
+            count += static_cast<qint64>(rect.width()) * rect.height();
+        }
+    }
+    return count;
+}
+
+qint64 QGVLayerTilesOnlineDownload::estimateBytes() const
+{
+    const qint64 average = (mDownloaded > 0) ? (mDownloadedBytes / mDownloaded) : mAverageTileBytes;
+    return estimateTiles() * average;
+}
+
+qint64 QGVLayerTilesOnlineDownload::processedTiles() const
+{
+    return mProcessed;
+}
+
+qint64 QGVLayerTilesOnlineDownload::failedTiles() const
+{
+    return mFailed;
+}
+
+bool QGVLayerTilesOnlineDownload::isRunning() const
+{
+    return mRunning;
+}
+
+void QGVLayerTilesOnlineDownload::start()
+{
+    if (mRunning || mLayer.isNull()) {
+        return;
+    }
+    qgvDebug() << "download started from zoom" << mCurZoom << "index" << mCurIndex;
+    mRunning = true;
+    // cache could be changed while job was stopped
+    mCachedZoom = -1;
+    fill();
+}
+
+void QGVLayerTilesOnlineDownload::stop()
+{
+    if (!mRunning) {
+        return;
+    }
+    mRunning = false;
+    const auto replies = mActive.keys();
+    for (QNetworkReply* reply : replies) {
+        reply->abort();
+    }
+    commitBatch();
+    qgvDebug() << "download stopped at zoom" << mCurZoom << "index" << mCurIndex;
+}
+
+QList<QRect> QGVLayerTilesOnlineDownload::zoomRects(int zoom) const
+{
+    QList<QRect> rects;
+    if (mLayer.isNull()) {
+        return rects;
+    }
+    for (const QGV::GeoRect& part : mAreaParts) {
+        const QRect rect = mLayer->getTileGrid().tilesRect(zoom, part);
+        if (!rect.isEmpty()) {
+            rects.append(rect);
+        }
+    }
+    return rects;
+}
+
+QSet<QGV::GeoTileId> QGVLayerTilesOnlineDownload::cachedIds(int zoom) const
+{
+    QSet<QGV::GeoTileId> ids;
+    if (mLayer.isNull()) {
+        return ids;
+    }
+    for (const QRect& rect : zoomRects(zoom)) {
+        // tiles of rect are descendants of their common ancestor, so they are selected by one range query
+        int delta = 0;
+        while (delta < zoom && ((rect.left() >> delta) != (rect.right() >> delta) ||
+                                (rect.top() >> delta) != (rect.bottom() >> delta))) {
+            delta++;
+        }
+        // grid may have several tiles at zero zoom level
+        for (int x = rect.left() >> delta; x <= (rect.right() >> delta); ++x) {
+            for (int y = rect.top() >> delta; y <= (rect.bottom() >> delta); ++y) {
+                const QGV::GeoTilePos root(zoom - delta, QPoint(x, y));
+                ids += mLayer->cachedTileIds(root, zoom);
+            }
+        }
+    }
+    return ids;
+}
+
+bool QGVLayerTilesOnlineDownload::nextTile(QGV::GeoTilePos& tilePos)
+{
+    while (mCurZoom <= mToZoom) {
+        // index runs through all parts of area one by one
+        qint64 index = mCurIndex;
+        for (const QRect& rect : zoomRects(mCurZoom)) {
+            const qint64 count = static_cast<qint64>(rect.width()) * rect.height();
+            if (index < count) {
+                const int x = rect.left() + static_cast<int>(index / rect.height());
+                const int y = rect.top() + static_cast<int>(index % rect.height());
+                mCurIndex++;
+                tilePos = QGV::GeoTilePos(mCurZoom, QPoint(x, y));
+                return true;
+            }
+            index -= count;
+        }
+        mCurZoom++;
+        mCurIndex = 0;
+    }
+    return false;
+}
+
+void QGVLayerTilesOnlineDownload::fill()
+{
+    if (!mRunning || mLayer.isNull()) {
+        return;
+    }
+    if (mLayer->isOfflineActive()) {
+        // download is continued when layer is back online
+        return;
+    }
+    while (mActive.size() < mMaxParallel) {
+        if (!mRetry.isEmpty()) {
+            download(mRetry.takeFirst());
+            continue;
+        }
+        QGV::GeoTilePos tilePos;
+        if (!nextTile(tilePos)) {
+            break;
+        }
+        if (tilePos.zoom() != mCachedZoom) {
+            mCachedIds = cachedIds(tilePos.zoom());
+            mCachedZoom = tilePos.zoom();
+        }
+        if (mCachedIds.contains(tilePos.toId())) {
+            onTileDone();
+            continue;
+        }
+        download({ tilePos, 0 });
+    }
+    if (mActive.isEmpty() && mRetry.isEmpty() && mScheduledRetries == 0 && mCurZoom > mToZoom) {
+        mRunning = false;
+        commitBatch();
+        qgvDebug() << "download finished, failed" << mFailed;
+        Q_EMIT finished();
+    }
+}
+
+void QGVLayerTilesOnlineDownload::download(const Task& task)
+{
+    QNetworkReply* reply = mLayer->downloadTile(task.tilePos);
+    mActive.insert(reply, task);
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { onReplyFinished(reply); });
+}
+
+void QGVLayerTilesOnlineDownload::onReplyFinished(QNetworkReply* reply)
+{
+    if (!mActive.contains(reply)) {
+        return;
+    }
+    Task task = mActive.take(reply);
+    reply->deleteLater();
+
+    if (reply->error() == QNetworkReply::OperationCanceledError) {
+        // job is stopped, paused by offline mode or network manager of layer is changed
+        mRetry.prepend(task);
+        QTimer::singleShot(0, this, &QGVLayerTilesOnlineDownload::fill);
+        return;
+    }
+    if (reply->error() != QNetworkReply::NoError) {
+        if (task.attempts < mMaxRetries) {
+            const int delay = retryDelayMs << task.attempts;
+            task.attempts++;
+            mScheduledRetries++;
+            QTimer::singleShot(delay, this, [this, task]() {
+                mScheduledRetries--;
+                mRetry.append(task);
+                fill();
+            });
+        } else {
+            qgvWarning() << "download failed" << task.tilePos << reply->errorString();
+            mFailed++;
+            onTileDone();
+        }
+        fill();
+        return;
+    }
+
+    const QByteArray rawImage = reply->readAll();
+    mBatch.append(qMakePair(task.tilePos, rawImage));
+    mDownloaded++;
+    mDownloadedBytes += rawImage.size();
+    if (mBatch.size() >= mBatchSize) {
+        commitBatch();
+    }
+    onTileDone();
+    fill();
+}
+
+void QGVLayerTilesOnlineDownload::onTileDone()
+{
+    mProcessed++;
+    Q_EMIT progress(mProcessed, estimateTiles());
+}
+
+void QGVLayerTilesOnlineDownload::onOfflineChanged(bool offline)
+{
+    if (!mRunning) {
+        return;
+    }
+    if (!offline) {
+        fill();
+        return;
+    }
+    // aborted tiles are put back to queue
+    const auto replies = mActive.keys();
+    for (QNetworkReply* reply : replies) {
+        reply->abort();
+    }
+}
+
+void QGVLayerTilesOnlineDownload::commitBatch()
+{
+    if (mLayer.isNull() || mBatch.isEmpty()) {
+        mBatch.clear();
+        return;
+    }
+    // transaction is held only while batch is written, not while tiles are downloaded
+    const auto batch = mBatch;
+    mBatch.clear();
+    mLayer->storeTiles(batch);
+}
@@ -0,0 +1,163 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "QGVLayerTilesOnlineWorker.h"
+#include "QGVMetrics.h"
+#include "Raster/QGVImage.h"
+
+#include <QNetworkDiskCache>
+
+QGVLayerTilesOnlineWorker::QGVLayerTilesOnlineWorker(QObject* parent)
+    : QObject(parent)
+    , mManager(nullptr)
+    , mCacheSize(0)
+{
+}
+
+QGVLayerTilesOnlineWorker::~QGVLayerTilesOnlineWorker()
+{
+}
+
+/*!
+ * Settings of layer network manager (proxy and disk cache), worker can't use that manager from its thread.
+ */
+void QGVLayerTilesOnlineWorker::setNetworkSettings(const QNetworkProxy& proxy,
+                                                   const QString& cacheDirectory,
+                                                   qint64 cacheSize)
+{
+    mProxy = proxy;
+    mCacheDirectory = cacheDirectory;
+    mCacheSize = cacheSize;
+    if (mManager != nullptr) {
+        applyNetworkSettings();
+    }
+}
+
+void QGVLayerTilesOnlineWorker::fetch(const Task& task)
+{
+    QGVMetrics* metrics = QGVMetrics::instance();
+    metrics->record(QGVMetrics::Stage::Queue, task.queuedUs, metrics->nowUs() - task.queuedUs);
+
+    auto it = mTasks.find(task.tilePos);
+    if (it != mTasks.end()) {
+        // download in progress (prefetch) is adopted by request
+        it->decode = it->decode || task.decode;
+        return;
+    }
+    if (task.cache && !task.decode && cache()->hasTileInCache(task.tileName)) {
+        // prefetched tile is already in cache
+        Q_EMIT tileLoaded(task.tilePos, QImage(), task.tileName, false);
+        return;
+    }
+    if (task.cache) {
+        const QByteArray rawImage = cache()->getTileFromCache(task.tilePos, task.tileName, task.provider);
+        if (!rawImage.isEmpty()) {
+            metrics->add(QGVMetrics::Counter::TilesFromDisk);
+            finishTile(task, rawImage, task.tileName);
+            return;
+        }
+    }
+    if (!task.network) {
+        Q_EMIT tileMissed(task.tilePos, task.decode);
+        return;
+    }
+    // manager is created in worker thread, so its replies are handled there too
+    if (mManager == nullptr) {
+        mManager = new QNetworkAccessManager(this);
+        applyNetworkSettings();
+    }
+    QNetworkReply* reply = mManager->get(task.request);
+    mTasks.insert(task.tilePos, task);
+    mReplies.insert(task.tilePos, reply);
+    const QGV::GeoTilePos tilePos = task.tilePos;
+    const qint64 started = metrics->nowUs();
+    connect(reply, &QNetworkReply::finished, this, [this, reply, tilePos, started]() {
+        onReplyFinished(reply, tilePos, started);
+    });
+}
+
+void QGVLayerTilesOnlineWorker::cancel(const QGV::GeoTilePos& tilePos)
+{
+    mTasks.remove(tilePos);
+    QNetworkReply* reply = mReplies.take(tilePos);
+    if (reply != nullptr) {
+        reply->abort();
+    }
+}
+
+void QGVLayerTilesOnlineWorker::applyNetworkSettings()
+{
+    mManager->setProxy(mProxy);
+    if (mCacheDirectory.isEmpty()) {
+        return;
+    }
+    auto cache = new QNetworkDiskCache(mManager);
+    cache->setCacheDirectory(mCacheDirectory);
+    cache->setMaximumCacheSize(mCacheSize);
+    mManager->setCache(cache);
+}
+
+QGVLayerTilesOnlineCache* QGVLayerTilesOnlineWorker::cache()
+{
+    // database connection is opened and used only by worker thread
+    if (mCache.isNull()) {
+        mCache.reset(new QGVLayerTilesOnlineCache());
+        mCache->init_cache();
+    }
+    return mCache.data();
+}
+
+void QGVLayerTilesOnlineWorker::onReplyFinished(QNetworkReply* reply, const QGV::GeoTilePos& tilePos, qint64 started)
+{
+    reply->deleteLater();
+    if (mReplies.value(tilePos, nullptr) != reply) {
+        // request was cancelled
+        return;
+    }
+    mReplies.remove(tilePos);
+    const Task task = mTasks.take(tilePos);
+
+    QGVMetrics* metrics = QGVMetrics::instance();
+    const qint64 latencyUs = metrics->nowUs() - started;
+    metrics->record(QGVMetrics::Stage::Network, started, latencyUs);
+
+    const bool failed = (reply->error() != QNetworkReply::NoError);
+    Q_EMIT mirrorFinished(task.mirror, failed, latencyUs / 1000);
+    if (failed) {
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        Q_EMIT tileFailed(tilePos, status, reply->errorString(), task.decode);
+        return;
+    }
+    metrics->add(QGVMetrics::Counter::TilesFromNetwork);
+    const QByteArray rawImage = reply->readAll();
+    if (task.cache) {
+        cache()->putTileToCache(tilePos, task.tileName, task.provider, rawImage);
+    }
+    finishTile(task, rawImage, reply->url().toString());
+}
+
+void QGVLayerTilesOnlineWorker::finishTile(const Task& task, const QByteArray& rawImage, const QString& source)
+{
+    QImage image;
+    if (task.decode) {
+        QGVMetrics::Scope scope(QGVMetrics::Stage::Decode);
+        // image is converted here, so GUI thread gets it ready for painting
+        image = QGVImage::toPaintFormat(QImage::fromData(rawImage), task.opaque);
+    }
+    Q_EMIT tileLoaded(task.tilePos, image, source, task.decode);
+}
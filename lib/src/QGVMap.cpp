@@ -21,11 +21,65 @@
 #include "QGVMapQGItem.h"
 #include "QGVMapQGView.h"
 #include "QGVProjectionEPSG3857.h"
+#include "QGVProjectionEPSG4326.h"
 #include "QGVWidget.h"
 
 #include <QMouseEvent>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
 #include <QVBoxLayout>
 
+#include <cmath>
+
+namespace {
+const int prepareTasksPerThread = 4;
+// thread hand-off costs more than projection of small number of points
+const int prepareInlineCost = 4096;
+
+class ProjectionPrepareTask : public QRunnable
+{
+public:
+    ProjectionPrepareTask(const QList<QGVItem*>& items,
+                          int from,
+                          int to,
+                          const QGVProjection* projection,
+                          QSemaphore* done)
+        : mItems(items)
+        , mFrom(from)
+        , mTo(to)
+        , mProjection(projection)
+        , mDone(done)
+    {
+    }
+
+    void run() override
+    {
+        for (int i = mFrom; i < mTo; ++i) {
+            mItems.at(i)->onProjectionPrepare(mProjection);
+        }
+        mDone->release();
+    }
+
+private:
+    const QList<QGVItem*>& mItems;
+    const int mFrom;
+    const int mTo;
+    const QGVProjection* mProjection;
+    QSemaphore* mDone;
+};
+
+void collectItems(QGVItem* parent, QList<QGVItem*>& items)
+{
+    for (int i = 0; i < parent->countItems(); ++i) {
+        QGVItem* item = parent->getItem(i);
+        items.append(item);
+        collectItems(item, items);
+    }
+}
+}
+
 class RootItem : public QGVItem
 {
 public:
@@ -48,6 +102,7 @@ RootItem::~RootItem() = default;
 QGVMap::QGVMap(QWidget* parent)
     : QWidget(parent)
 {
+    mWorldCopies = false;
     mProjection.reset(new QGVProjectionEPSG3857());
     mQGView.reset(new QGVMapQGView(this));
     mRootItem.reset(new RootItem(this));
@@ -88,6 +143,9 @@ void QGVMap::setProjection(QGV::Projection id)
         case QGV::Projection::EPSG3857:
             setProjection(new QGVProjectionEPSG3857());
             break;
+        case QGV::Projection::EPSG4326:
+            setProjection(new QGVProjectionEPSG4326());
+            break;
     }
 }
 
@@ -104,6 +162,80 @@ QGVProjection* QGVMap::getProjection() const
     return mProjection.data();
 }
 
+/*!
+ * World copies are drawn to the left and to the right of projection boundary, if projection wraps around.
+ * Copies are rendered from the same items, so they don't need additional memory.
+ */
+void QGVMap::setWorldCopies(bool enabled)
+{
+    mWorldCopies = enabled;
+    geoView()->updateWorldCopies();
+}
+
+bool QGVMap::isWorldCopies() const
+{
+    return mWorldCopies;
+}
+
+bool QGVMap::isWorldWrap() const
+{
+    return mWorldCopies && mProjection->isWrapAround();
+}
+
+/*!
+ * Horizontal offsets of world copies which are visible in projRect (0 is canonical world).
+ */
+QList<double> QGVMap::worldOffsets(const QRectF& projRect) const
+{
+    if (!isWorldWrap()) {
+        return { 0.0 };
+    }
+    const QRectF world = mProjection->boundaryProjRect();
+    const int first = static_cast<int>(std::floor((projRect.left() - world.left()) / world.width()));
+    const int last = static_cast<int>(std::floor((projRect.right() - world.left()) / world.width()));
+    QList<double> result;
+    for (int copy = first; copy <= last; ++copy) {
+        result.append(copy * world.width());
+    }
+    return result;
+}
+
+/*!
+ * Position moved from world copy to canonical world.
+ */
+QPointF QGVMap::foldProjPos(const QPointF& projPos) const
+{
+    if (!isWorldWrap()) {
+        return projPos;
+    }
+    const QRectF world = mProjection->boundaryProjRect();
+    const double copy = std::floor((projPos.x() - world.left()) / world.width());
+    return QPointF(projPos.x() - copy * world.width(), projPos.y());
+}
+
+/*!
+ * Parts of projRect moved from world copies to canonical world.
+ */
+QList<QRectF> QGVMap::foldProjRect(const QRectF& projRect) const
+{
+    if (!isWorldWrap()) {
+        return { projRect };
+    }
+    const QRectF world = mProjection->boundaryProjRect();
+    if (projRect.width() >= world.width()) {
+        return { QRectF(world.left(), projRect.top(), world.width(), projRect.height()) };
+    }
+    QList<QRectF> result;
+    for (double offset : worldOffsets(projRect)) {
+        const QRectF strip(world.left() + offset, projRect.top(), world.width(), projRect.height());
+        const QRectF part = projRect.intersected(strip).translated(-offset, 0);
+        if (!part.isEmpty()) {
+            result.append(part);
+        }
+    }
+    return result;
+}
+
 void QGVMap::setMouseActions(QGV::MouseActions actions)
 {
     geoView()->setMouseActions(actions);
@@ -236,7 +368,7 @@ QSet<QGVItem*> QGVMap::getSelections() const
 QList<QGVDrawItem*> QGVMap::search(const QPointF& projPos, Qt::ItemSelectionMode mode) const
 {
     QList<QGVDrawItem*> result;
-    for (QGraphicsItem* item : geoView()->scene()->items(projPos, mode)) {
+    for (QGraphicsItem* item : geoView()->scene()->items(foldProjPos(projPos), mode)) {
         QGVDrawItem* geoObject = QGVMapQGItem::geoObjectFromQGItem(item);
         if (geoObject)
             result << geoObject;
@@ -247,10 +379,12 @@ QList<QGVDrawItem*> QGVMap::search(const QPointF& projPos, Qt::ItemSelectionMode
 QList<QGVDrawItem*> QGVMap::search(const QRectF& projRect, Qt::ItemSelectionMode mode) const
 {
     QList<QGVDrawItem*> result;
-    for (QGraphicsItem* item : geoView()->scene()->items(projRect, mode)) {
-        QGVDrawItem* geoObject = QGVMapQGItem::geoObjectFromQGItem(item);
-        if (geoObject)
-            result << geoObject;
+    for (double offset : worldOffsets(projRect)) {
+        for (QGraphicsItem* item : geoView()->scene()->items(projRect.translated(-offset, 0), mode)) {
+            QGVDrawItem* geoObject = QGVMapQGItem::geoObjectFromQGItem(item);
+            if (geoObject && !result.contains(geoObject))
+                result << geoObject;
+        }
     }
     return result;
 }
@@ -258,10 +392,12 @@ QList<QGVDrawItem*> QGVMap::search(const QRectF& projRect, Qt::ItemSelectionMode
 QList<QGVDrawItem*> QGVMap::search(const QPolygonF& projPolygon, Qt::ItemSelectionMode mode) const
 {
     QList<QGVDrawItem*> result;
-    for (QGraphicsItem* item : geoView()->scene()->items(projPolygon, mode)) {
-        QGVDrawItem* geoObject = QGVMapQGItem::geoObjectFromQGItem(item);
-        if (geoObject)
-            result << geoObject;
+    for (double offset : worldOffsets(projPolygon.boundingRect())) {
+        for (QGraphicsItem* item : geoView()->scene()->items(projPolygon.translated(-offset, 0), mode)) {
+            QGVDrawItem* geoObject = QGVMapQGItem::geoObjectFromQGItem(item);
+            if (geoObject && !result.contains(geoObject))
+                result << geoObject;
+        }
     }
     return result;
 }
@@ -317,11 +453,67 @@ void QGVMap::refreshProjection()
     geoView()->scene()->setSceneRect(sceneRect);
 
     auto root = static_cast<RootItem*>(rootItem());
+
+    // projected geometry is calculated in parallel and then committed to scene serially
+    QList<QGVItem*> items;
+    collectItems(root, items);
+    prepareProjection(items);
     root->onProjection(this);
+    for (QGVItem* item : items) {
+        item->mProjectionPrepared = false;
+    }
 
     for (QGVWidget* widget : mWidgets) {
         widget->onProjection(this);
     }
+    geoView()->updateWorldCopies();
+}
+
+void QGVMap::prepareProjection(const QList<QGVItem*>& items)
+{
+    if (items.isEmpty()) {
+        return;
+    }
+    // gate is based on work, few polygons with many points are worth threads as well as many small items
+    QVector<int> costs;
+    costs.reserve(items.size());
+    qint64 totalCost = 0;
+    for (QGVItem* item : items) {
+        costs.append(qMax(1, item->projectionCost()));
+        totalCost += costs.last();
+    }
+    if (items.size() < 2 || totalCost < prepareInlineCost || QThread::idealThreadCount() < 2) {
+        for (QGVItem* item : items) {
+            item->onProjectionPrepare(mProjection.data());
+            item->mProjectionPrepared = true;
+        }
+        return;
+    }
+    // own pool, so waiting here is not blocked by long tasks of application in global pool
+    if (mPreparePool.isNull()) {
+        mPreparePool.reset(new QThreadPool());
+    }
+    QThreadPool* pool = mPreparePool.data();
+    const int tasksCount = qMin(items.size(), qMax(1, pool->maxThreadCount()) * prepareTasksPerThread);
+    // chunks have equal cost rather than equal number of items
+    const qint64 chunkCost = (totalCost + tasksCount - 1) / tasksCount;
+    QSemaphore done;
+    int started = 0;
+    int from = 0;
+    qint64 cost = 0;
+    for (int i = 0; i < items.size(); ++i) {
+        cost += costs.at(i);
+        if (cost >= chunkCost || i + 1 == items.size()) {
+            pool->start(new ProjectionPrepareTask(items, from, i + 1, mProjection.data(), &done));
+            started++;
+            from = i + 1;
+            cost = 0;
+        }
+    }
+    done.acquire(started);
+    for (QGVItem* item : items) {
+        item->mProjectionPrepared = true;
+    }
 }
 
 void QGVMap::anchoreWidgets()
@@ -364,6 +556,14 @@ void QGVMap::onMapCamera(const QGVCameraState& oldState, const QGVCameraState& n
     }
 }
 
+void QGVMap::onMapTrajectory(const QList<QGVCameraState>& states)
+{
+    auto root = static_cast<RootItem*>(rootItem());
+    if (root->isVisible()) {
+        root->onTrajectory(states);
+    }
+}
+
 void QGVMap::mouseMoveEvent(QMouseEvent* event)
 {
     if (hasMouseTracking()) {
@@ -385,7 +585,7 @@ void QGVMap::mousePressEvent(QMouseEvent* event)
 void QGVMap::handleDropDataOnQGVMapQGView(QPointF position, const QMimeData* dropData)
 {
     const auto mapToProjectionPos = mapToProj(QPoint(position.rx(), position.ry()));
-    auto geoPos = getProjection()->projToGeo(mapToProjectionPos);
+    auto geoPos = getProjection()->projToGeo(foldProjPos(mapToProjectionPos));
     Q_EMIT dropOnMap(geoPos, dropData);
 }
 
@@ -18,7 +18,9 @@
 
 #include "QGVMapQGItem.h"
 #include "QGVDrawItem.h"
+#include "QGVMapQGView.h"
 
+#include <QElapsedTimer>
 #include <QGraphicsSceneMouseEvent>
 #include <QPainter>
 #include <QPalette>
@@ -26,6 +28,8 @@
 QGVMapQGItem::QGVMapQGItem(QGVDrawItem* geoObject)
 {
     mGeoObject = geoObject;
+    mPaintCount = 0;
+    mShapeCount = 0;
     setCacheMode(QGraphicsItem::DeviceCoordinateCache);
 }
 
@@ -40,14 +44,43 @@ void QGVMapQGItem::resetGeometry()
     prepareGeometryChange();
 }
 
+/*!
+ * Paint calls counter, available when library is built with QGV_DEBUG_COUNTERS.
+ */
+int QGVMapQGItem::getPaintCount() const
+{
+    return mPaintCount;
+}
+
+/*!
+ * Calls of projShape() made by scene (bounding rect and shape queries), available when library is built
+ * with QGV_DEBUG_COUNTERS.
+ */
+int QGVMapQGItem::getShapeCount() const
+{
+    return mShapeCount;
+}
+
 QRectF QGVMapQGItem::boundingRect() const
 {
+#ifdef QGV_DEBUG_COUNTERS
+    mShapeCount++;
+#endif
     return mGeoObject->projShape().boundingRect();
 }
 
 void QGVMapQGItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*option*/, QWidget* /*widget*/)
 {
+    QGVMapQGView* view = mGeoObject->getMap()->geoView();
+    QElapsedTimer timer;
+    if (view->isPaintProfiling()) {
+        timer.start();
+    }
+
     mGeoObject->projPaint(painter);
+#ifdef QGV_DEBUG_COUNTERS
+    mPaintCount++;
+#endif
 
     if (mGeoObject->isSelected() && !mGeoObject->isFlag(QGV::ItemFlag::SelectCustom)) {
         QPen pen = QPen(mGeoObject->getMap()->palette().highlight(), 1, Qt::DashLine);
@@ -59,17 +92,22 @@ void QGVMapQGItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*op
     }
 
     if (QGV::isDrawDebug()) {
-        mGeoObject->setProperty("paintCount", mGeoObject->property("paintCount").toInt() + 1);
         QPen pen = QPen(Qt::black);
         pen.setWidth(1);
         pen.setCosmetic(true);
         QBrush brush = QBrush(Qt::white);
         painter->setPen(pen);
         painter->setBrush(brush);
-        auto rect = boundingRect().toRect();
-        auto path = QGV::createTextPath(rect, mGeoObject->projDebug(), QFont(), pen.width());
-        path = QGV::createTransfromScale(rect.center(), 0.75).map(path);
-        painter->drawPath(path);
+        const QRect rect = boundingRect().toRect();
+        const QString text = mGeoObject->projDebug();
+        if (text != mDebugText || rect != mDebugRect) {
+            // glyph path is expensive, so it is rebuilt only when text or geometry changes
+            mDebugText = text;
+            mDebugRect = rect;
+            mDebugPath = QGV::createTextPath(rect, text, QFont(), pen.width());
+            mDebugPath = QGV::createTransfromScale(rect.center(), 0.75).map(mDebugPath);
+        }
+        painter->drawPath(mDebugPath);
 
         pen = QPen(Qt::black);
         pen.setStyle(Qt::DashLine);
@@ -79,11 +117,29 @@ void QGVMapQGItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*op
         painter->setPen(pen);
         painter->setBrush(brush);
         painter->drawRect(rect);
+
+#ifdef QGV_DEBUG_COUNTERS
+        // counters change on every refresh and paint, so they are drawn as plain text in device coordinates
+        const QRectF deviceRect = painter->worldTransform().mapRect(QRectF(rect));
+        painter->save();
+        painter->resetTransform();
+        painter->drawText(deviceRect,
+                          Qt::AlignLeft | Qt::AlignTop,
+                          QString("update(%1,%2)").arg(mGeoObject->getUpdateCount()).arg(mPaintCount));
+        painter->restore();
+#endif
+    }
+
+    if (timer.isValid()) {
+        view->addPaintTime(mGeoObject, timer.nsecsElapsed() / 1000);
     }
 }
 
 QPainterPath QGVMapQGItem::shape() const
 {
+#ifdef QGV_DEBUG_COUNTERS
+    mShapeCount++;
+#endif
     return mGeoObject->projShape();
 }
 
@@ -25,6 +25,7 @@
 #include "QGVWidget.h"
 
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QParallelAnimationGroup>
 #include <QScrollBar>
 #include <QSequentialAnimationGroup>
@@ -51,6 +52,7 @@ QGVMapQGView::QGVMapQGView(QGVMap* geoMap)
     mMouseActions = QGV::MouseAction::All;
     mViewRect = viewport()->rect();
     mState = QGV::MapState::Idle;
+    mPaintProfiling = false;
     mQGScene.reset(new QGraphicsScene(this));
     mSelectionRect.reset(new QGVMapRubberBand(this));
     mSelectionRect->setMinSelection(QSize(5, 5));
@@ -124,6 +126,49 @@ QRectF QGVMapQGView::viewRect() const
     return mapToScene(mViewRect).boundingRect();
 }
 
+/*!
+ * Paint time of frames and layers is collected while enabled (used by QGVWidgetProfiler).
+ */
+void QGVMapQGView::setPaintProfiling(bool enabled)
+{
+    mPaintProfiling = enabled;
+}
+
+bool QGVMapQGView::isPaintProfiling() const
+{
+    return mPaintProfiling;
+}
+
+void QGVMapQGView::addPaintTime(const QGVItem* item, qint64 paintUs)
+{
+    // time is accounted to top level item, which is usually a layer
+    const QGVItem* root = mGeoMap->rootItem();
+    while (item->getParent() != nullptr && item->getParent() != root) {
+        item = item->getParent();
+    }
+    if (!mPaintItems.contains(item)) {
+        // address of deleted item may be reused by new one, so stats are dropped with item
+        mPaintItems.insert(item);
+        connect(item, &QObject::destroyed, this, [this, item]() {
+            mPaintItems.remove(item);
+            mPaintStats.layerPaintUs.remove(item);
+            mPaintStats.layerPaintCount.remove(item);
+        });
+    }
+    mPaintStats.layerPaintUs[item] += paintUs;
+    mPaintStats.layerPaintCount[item] += 1;
+}
+
+const QGVPaintStats& QGVMapQGView::getPaintStats() const
+{
+    return mPaintStats;
+}
+
+void QGVMapQGView::resetPaintStats()
+{
+    mPaintStats = QGVPaintStats();
+}
+
 void QGVMapQGView::changeState(QGV::MapState state)
 {
     if (mState == state) {
@@ -180,11 +225,88 @@ void QGVMapQGView::cameraMove(const QPointF& projPos)
 {
     const QGVCameraState oldState = getCamera();
     const QPointF oldCenter = viewRect().center();
-    if (oldCenter != projPos) {
-        QGraphicsView::centerOn(projPos);
+    // camera stays in canonical world, world copies are drawn around it
+    const QPointF newCenter = mGeoMap->foldProjPos(projPos);
+    const QPointF shift = newCenter - projPos;
+    mMoveProjAnchor += shift;
+    mWheelProjAnchor += shift;
+    if (oldCenter != newCenter) {
+        QGraphicsView::centerOn(newCenter);
         applyCameraUpdate(oldState);
-        qgvDebug() << "cameraMove" << projPos;
+        qgvDebug() << "cameraMove" << newCenter;
+    }
+}
+
+/*!
+ * World copies are cached as one viewport sized pixmap, which is rendered again after camera or projection change.
+ * Scene changes are tracked only while copies are visible.
+ */
+void QGVMapQGView::updateWorldCopies()
+{
+    const bool visible = mGeoMap->isWorldWrap() && mGeoMap->worldOffsets(viewRect()).size() > 1;
+    if (!visible) {
+        disconnect(mCopiesConnection);
+        mCopiesConnection = {};
+        mCopiesCache = QPixmap();
+        mCopiesDirty = QRegion();
+        return;
     }
+    if (!mCopiesConnection) {
+        mCopiesConnection = connect(mQGScene.data(), &QGraphicsScene::changed, this, &QGVMapQGView::onSceneChanged);
+    }
+    mCopiesDirty = viewport()->rect();
+    viewport()->update();
+}
+
+void QGVMapQGView::onSceneChanged(const QList<QRectF>& region)
+{
+    const QRectF projView = viewRect();
+    for (const QRectF& projRect : region) {
+        for (double offset : mGeoMap->worldOffsets(projView)) {
+            const QRectF projCopy = projRect.translated(offset, 0);
+            if (offset == 0.0 || !projCopy.intersects(projView)) {
+                continue;
+            }
+            const QRect dirty = mapFromScene(projCopy).boundingRect().adjusted(-1, -1, 1, 1);
+            mCopiesDirty += dirty;
+            viewport()->update(dirty);
+        }
+    }
+}
+
+void QGVMapQGView::drawWorldCopies()
+{
+    const qreal ratio = viewport()->devicePixelRatioF();
+    const QSize size = viewport()->size() * ratio;
+    if (mCopiesCache.size() != size) {
+        mCopiesCache = QPixmap(size);
+        mCopiesCache.setDevicePixelRatio(ratio);
+        mCopiesCache.fill(Qt::transparent);
+        mCopiesDirty = viewport()->rect();
+    }
+    QPainter painter(&mCopiesCache);
+    painter.setRenderHints(renderHints());
+    painter.setClipRegion(mCopiesDirty);
+    painter.setCompositionMode(QPainter::CompositionMode_Clear);
+    painter.fillRect(mCopiesDirty.boundingRect(), Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.setTransform(viewportTransform());
+
+    // copies are rendered from canonical world by translation, items are not duplicated
+    const QRectF world = mGeoMap->getProjection()->boundaryProjRect();
+    const QRectF dirty = mapToScene(mCopiesDirty.boundingRect()).boundingRect();
+    for (double offset : mGeoMap->worldOffsets(dirty)) {
+        if (offset == 0.0) {
+            continue;
+        }
+        const QRectF target =
+                dirty.intersected(QRectF(world.left() + offset, dirty.top(), world.width(), dirty.height()));
+        if (target.isEmpty()) {
+            continue;
+        }
+        scene()->render(&painter, target, target.translated(-offset, 0), Qt::IgnoreAspectRatio);
+    }
+    mCopiesDirty = QRegion();
 }
 
 void QGVMapQGView::blockCameraUpdate()
@@ -209,6 +331,7 @@ void QGVMapQGView::applyCameraUpdate(const QGVCameraState& oldState)
     if (oldState == newState) {
         return;
     }
+    updateWorldCopies();
     mGeoMap->onMapCamera(oldState, newState);
 }
 
@@ -218,9 +341,8 @@ void QGVMapQGView::showTooltip(QHelpEvent* helpEvent)
         return;
     }
     helpEvent->accept();
-    const QPointF projMouse = mapToScene(helpEvent->pos());
-    QGraphicsItem* item = itemAt(helpEvent->pos());
-    QGVDrawItem* geoObject = QGVMapQGItem::geoObjectFromQGItem(item);
+    const QPointF projMouse = mGeoMap->foldProjPos(mapToScene(helpEvent->pos()));
+    QGVDrawItem* geoObject = mGeoMap->search(projMouse, Qt::IntersectsItemShape).value(0, nullptr);
     QString toolTip = QString();
     if (geoObject != nullptr) {
         toolTip = geoObject->projTooltip(projMouse);
@@ -299,7 +421,7 @@ void QGVMapQGView::startMovingObject(QMouseEvent* event)
         changeState(QGV::MapState::Idle);
         return;
     }
-    const QPointF projPos = mapToScene(event->pos());
+    const QPointF projPos = mGeoMap->foldProjPos(mapToScene(event->pos()));
     auto geoObjects = mGeoMap->search(projPos, Qt::ContainsItemShape);
     if (geoObjects.isEmpty()) {
         return;
@@ -340,7 +462,7 @@ void QGVMapQGView::stopSelectionRect(QMouseEvent* event)
 void QGVMapQGView::stopMovingObject(QMouseEvent* event)
 {
     Q_ASSERT(mMovingObject);
-    const QPointF projPos = mapToScene(event->pos());
+    const QPointF projPos = mGeoMap->foldProjPos(mapToScene(event->pos()));
     mMovingObject->projOnObjectStopMove(projPos);
     changeState(QGV::MapState::Idle);
 }
@@ -389,7 +511,7 @@ void QGVMapQGView::objectClick(QMouseEvent* event)
     if (event->button() != Qt::LeftButton) {
         return;
     }
-    const QPointF projPos = mapToScene(event->pos());
+    const QPointF projPos = mGeoMap->foldProjPos(mapToScene(event->pos()));
     auto geoObjects = mGeoMap->search(projPos, Qt::ContainsItemShape);
     if (geoObjects.isEmpty()) {
         return;
@@ -419,7 +541,7 @@ void QGVMapQGView::objectDoubleClick(QMouseEvent* event)
     if (event->button() != Qt::LeftButton) {
         return;
     }
-    const QPointF projPos = mapToScene(event->pos());
+    const QPointF projPos = mGeoMap->foldProjPos(mapToScene(event->pos()));
     auto geoObjects = mGeoMap->search(projPos, Qt::ContainsItemShape);
     if (geoObjects.isEmpty()) {
         return;
@@ -477,7 +599,7 @@ void QGVMapQGView::moveObject(QMouseEvent* event)
     }
     Q_ASSERT(mMovingObject);
     event->accept();
-    const QPointF projMouse = mapToScene(event->pos());
+    const QPointF projMouse = mGeoMap->foldProjPos(mapToScene(event->pos()));
     mMovingObject->projOnObjectMovePos(projMouse);
 }
 
@@ -626,3 +748,35 @@ void QGVMapQGView::dragLeaveEvent(QDragLeaveEvent* event)
 {
     event->accept();
 }
+
+void QGVMapQGView::paintEvent(QPaintEvent* event)
+{
+    if (!mPaintProfiling) {
+        QGraphicsView::paintEvent(event);
+        return;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    QGraphicsView::paintEvent(event);
+    const qint64 frameUs = timer.nsecsElapsed() / 1000;
+    mPaintStats.frames++;
+    mPaintStats.lastFrameUs = frameUs;
+    mPaintStats.totalFrameUs += frameUs;
+    mPaintStats.maxFrameUs = qMax(mPaintStats.maxFrameUs, frameUs);
+}
+
+void QGVMapQGView::drawForeground(QPainter* painter, const QRectF& rect)
+{
+    QGraphicsView::drawForeground(painter, rect);
+    if (!mCopiesConnection) {
+        return;
+    }
+    // items are painted for copies only when their part of cache is invalid
+    if (!mCopiesDirty.isEmpty()) {
+        drawWorldCopies();
+    }
+    painter->save();
+    painter->resetTransform();
+    painter->drawPixmap(0, 0, mCopiesCache);
+    painter->restore();
+}
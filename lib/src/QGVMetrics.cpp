@@ -0,0 +1,294 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "QGVMetrics.h"
+
+#include <QFile>
+#include <QMutexLocker>
+#include <QThread>
+
+namespace {
+// trace is bounded, oldest events are kept
+const int traceMaxEvents = 200000;
+
+int bucketOf(qint64 durationUs)
+{
+    int bucket = 0;
+    quint64 value = static_cast<quint64>(qMax<qint64>(1, durationUs)) >> 1;
+    while (value != 0 && bucket < QGVMetrics::HistogramBuckets - 1) {
+        value >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+}
+
+const int QGVMetrics::CounterCount;
+const int QGVMetrics::StageCount;
+const int QGVMetrics::HistogramBuckets;
+
+/*!
+ * Upper bound of histogram bucket, buckets are powers of two of microseconds.
+ */
+qint64 QGVMetrics::Histogram::bucketUpperUs(int bucket)
+{
+    return static_cast<qint64>(2) << bucket;
+}
+
+double QGVMetrics::Histogram::averageUs() const
+{
+    return (count > 0) ? static_cast<double>(totalUs) / count : 0.0;
+}
+
+/*!
+ * Percentile estimated by bucket bound, so it is precise up to factor of two.
+ */
+qint64 QGVMetrics::Histogram::percentileUs(double percentile) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    const qint64 rank = qMax<qint64>(1, static_cast<qint64>(qBound(0.0, percentile, 1.0) * count + 0.5));
+    qint64 sum = 0;
+    for (int bucket = 0; bucket < buckets.size(); ++bucket) {
+        sum += buckets[bucket];
+        if (sum >= rank) {
+            return qMin(bucketUpperUs(bucket), maxUs);
+        }
+    }
+    return maxUs;
+}
+
+QGVMetrics::Scope::Scope(Stage stage)
+    : mStage(stage)
+    , mStartUs(-1)
+{
+    QGVMetrics* metrics = QGVMetrics::instance();
+    if (metrics->isEnabled()) {
+        mStartUs = metrics->nowUs();
+    }
+}
+
+QGVMetrics::Scope::~Scope()
+{
+    if (mStartUs < 0) {
+        return;
+    }
+    QGVMetrics* metrics = QGVMetrics::instance();
+    metrics->record(mStage, mStartUs, metrics->nowUs() - mStartUs);
+}
+
+QGVMetrics::QGVMetrics()
+    : mEnabled(false)
+    , mTraceEnabled(false)
+{
+    mClock.start();
+    reset();
+}
+
+QGVMetrics* QGVMetrics::instance()
+{
+    static QGVMetrics metrics;
+    return &metrics;
+}
+
+void QGVMetrics::setEnabled(bool enabled)
+{
+    mEnabled.store(enabled, std::memory_order_relaxed);
+    qgvDebug() << "Metrics changed to" << enabled;
+}
+
+bool QGVMetrics::isEnabled() const
+{
+    return mEnabled.load(std::memory_order_relaxed);
+}
+
+/*!
+ * Trace events are collected only while metrics are enabled.
+ */
+void QGVMetrics::setTraceEnabled(bool enabled)
+{
+    mTraceEnabled.store(enabled, std::memory_order_relaxed);
+    qgvDebug() << "MetricsTrace changed to" << enabled;
+}
+
+bool QGVMetrics::isTraceEnabled() const
+{
+    return mTraceEnabled.load(std::memory_order_relaxed);
+}
+
+void QGVMetrics::reset()
+{
+    for (auto& counter : mCounters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    for (auto& stage : mStages) {
+        for (auto& bucket : stage.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        stage.count.store(0, std::memory_order_relaxed);
+        stage.totalUs.store(0, std::memory_order_relaxed);
+        stage.maxUs.store(0, std::memory_order_relaxed);
+    }
+    QMutexLocker locker(&mTraceLock);
+    mTrace.clear();
+}
+
+void QGVMetrics::add(Counter counter, qint64 value)
+{
+    if (!isEnabled()) {
+        return;
+    }
+    mCounters[static_cast<int>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+void QGVMetrics::record(Stage stage, qint64 startUs, qint64 durationUs)
+{
+    if (!isEnabled()) {
+        return;
+    }
+    durationUs = qMax<qint64>(0, durationUs);
+    StageData& data = mStages[static_cast<int>(stage)];
+    data.buckets[bucketOf(durationUs)].fetch_add(1, std::memory_order_relaxed);
+    data.count.fetch_add(1, std::memory_order_relaxed);
+    data.totalUs.fetch_add(durationUs, std::memory_order_relaxed);
+    qint64 maxUs = data.maxUs.load(std::memory_order_relaxed);
+    while (durationUs > maxUs && !data.maxUs.compare_exchange_weak(maxUs, durationUs, std::memory_order_relaxed)) {
+    }
+
+    if (!isTraceEnabled()) {
+        return;
+    }
+    const TraceEvent event = { stage, startUs, durationUs,
+                               static_cast<quint64>(reinterpret_cast<quintptr>(QThread::currentThreadId())) };
+    QMutexLocker locker(&mTraceLock);
+    if (mTrace.size() < traceMaxEvents) {
+        mTrace.append(event);
+    }
+}
+
+/*!
+ * Monotonic time in microseconds, same time base is used by trace events.
+ */
+qint64 QGVMetrics::nowUs() const
+{
+    return mClock.nsecsElapsed() / 1000;
+}
+
+qint64 QGVMetrics::counter(Counter counter) const
+{
+    return mCounters[static_cast<int>(counter)].load(std::memory_order_relaxed);
+}
+
+QGVMetrics::Histogram QGVMetrics::histogram(Stage stage) const
+{
+    const StageData& data = mStages[static_cast<int>(stage)];
+    Histogram result;
+    result.buckets.resize(HistogramBuckets);
+    for (int bucket = 0; bucket < HistogramBuckets; ++bucket) {
+        result.buckets[bucket] = data.buckets[bucket].load(std::memory_order_relaxed);
+    }
+    result.count = data.count.load(std::memory_order_relaxed);
+    result.totalUs = data.totalUs.load(std::memory_order_relaxed);
+    result.maxUs = data.maxUs.load(std::memory_order_relaxed);
+    return result;
+}
+
+/*!
+ * Trace in Chrome trace event format, current counters are stored in "otherData".
+ */
+QByteArray QGVMetrics::traceJson() const
+{
+    QByteArray json = "{\"traceEvents\":[";
+    {
+        QMutexLocker locker(&mTraceLock);
+        json.reserve(json.size() + mTrace.size() * 96);
+        for (int index = 0; index < mTrace.size(); ++index) {
+            const TraceEvent& event = mTrace[index];
+            if (index > 0) {
+                json += ',';
+            }
+            json += "{\"name\":\"";
+            json += stageName(event.stage);
+            json += "\",\"cat\":\"tiles\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+            json += QByteArray::number(event.thread);
+            json += ",\"ts\":";
+            json += QByteArray::number(event.startUs);
+            json += ",\"dur\":";
+            json += QByteArray::number(event.durationUs);
+            json += '}';
+        }
+    }
+    json += "],\"otherData\":{";
+    for (int index = 0; index < CounterCount; ++index) {
+        const Counter id = static_cast<Counter>(index);
+        if (index > 0) {
+            json += ',';
+        }
+        json += '"';
+        json += counterName(id);
+        json += "\":";
+        json += QByteArray::number(counter(id));
+    }
+    json += "}}";
+    return json;
+}
+
+bool QGVMetrics::saveTrace(const QString& fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qgvWarning() << "can't write trace" << fileName << file.errorString();
+        return false;
+    }
+    return file.write(traceJson()) >= 0;
+}
+
+const char* QGVMetrics::counterName(Counter counter)
+{
+    switch (counter) {
+        case Counter::TilesRequested:
+            return "tilesRequested";
+        case Counter::TilesFromMemory:
+            return "tilesFromMemory";
+        case Counter::TilesFromDisk:
+            return "tilesFromDisk";
+        case Counter::TilesFromNetwork:
+            return "tilesFromNetwork";
+        case Counter::TilesCanceled:
+            return "tilesCanceled";
+        case Counter::TilesFailed:
+            return "tilesFailed";
+    }
+    return "";
+}
+
+const char* QGVMetrics::stageName(Stage stage)
+{
+    switch (stage) {
+        case Stage::Queue:
+            return "queue";
+        case Stage::Network:
+            return "network";
+        case Stage::Decode:
+            return "decode";
+        case Stage::AddToScene:
+            return "addToScene";
+    }
+    return "";
+}
@@ -18,6 +18,8 @@
 
 #include <QGVProjection.h>
 
+#include <QtMath>
+
 QGVProjection::QGVProjection(const QString& id, const QString& name, const QString& description)
     : mID(id)
     , mName(name)
@@ -39,3 +41,37 @@ QString QGVProjection::getDescription() const
 {
     return mDescription;
 }
+
+bool QGVProjection::isWrapAround() const
+{
+    return false;
+}
+
+void QGVProjection::geoToProjArray(const double* lat, const double* lon, double* x, double* y, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        const QPointF projPos = geoToProj(QGV::GeoPos(lat[i], lon[i]));
+        x[i] = projPos.x();
+        y[i] = projPos.y();
+    }
+}
+
+void QGVProjection::projToGeoArray(const double* x, const double* y, double* lat, double* lon, size_t count) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        const QGV::GeoPos geoPos = projToGeo(QPointF(x[i], y[i]));
+        lat[i] = geoPos.latitude();
+        lon[i] = geoPos.longitude();
+    }
+}
+
+double QGVProjection::haversineMeters(const QGV::GeoPos& geoPos1, const QGV::GeoPos& geoPos2, double radius)
+{
+    const double latitudeArc = (geoPos1.latitude() - geoPos2.latitude()) * M_PI / 180.0;
+    const double longitudeArc = (geoPos1.longitude() - geoPos2.longitude()) * M_PI / 180.0;
+    const double latitudeH = qPow(sin(latitudeArc * 0.5), 2);
+    const double lontitudeH = qPow(sin(longitudeArc * 0.5), 2);
+    const double lonFactor = cos(geoPos1.latitude() * M_PI / 180.0) * cos(geoPos2.latitude() * M_PI / 180.0);
+    const double arcInRadians = 2.0 * asin(sqrt(latitudeH + lonFactor * lontitudeH));
+    return radius * arcInRadians;
+}
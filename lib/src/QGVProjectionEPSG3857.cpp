@@ -21,6 +21,9 @@
 #include <QLineF>
 #include <QtMath>
 
+#include <algorithm>
+#include <cmath>
+
 QGVProjectionEPSG3857::QGVProjectionEPSG3857()
     : QGVProjection("EPSG3857",
                     "WGS84 Web Mercator",
@@ -31,6 +34,8 @@ QGVProjectionEPSG3857::QGVProjectionEPSG3857()
     mEarthRadius = 6378137.0; /* meters */
     mOriginShift = 2.0 * M_PI * mEarthRadius / 2.0;
     mGeoBoundary = QGV::GeoRect(85, -180, -85, +180);
+    mMaxLatitude = mGeoBoundary.latTop();
+    mMinLatitude = mGeoBoundary.latBottom();
     mProjBoundary = geoToProj(mGeoBoundary);
 }
 
@@ -44,11 +49,15 @@ QRectF QGVProjectionEPSG3857::boundaryProjRect() const
     return mProjBoundary;
 }
 
+bool QGVProjectionEPSG3857::isWrapAround() const
+{
+    return true;
+}
+
 QPointF QGVProjectionEPSG3857::geoToProj(const QGV::GeoPos& geoPos) const
 {
     const double lon = geoPos.longitude();
-    const double lat = (geoPos.latitude() > mGeoBoundary.topLeft().latitude()) ? mGeoBoundary.topLeft().latitude()
-                                                                               : geoPos.latitude();
+    const double lat = qBound(mMinLatitude, geoPos.latitude(), mMaxLatitude);
     const double x = lon * mOriginShift / 180.0;
     const double preY = -qLn(qTan((90.0 + lat) * M_PI / 360.0)) / (M_PI / 180.0);
     const double y = preY * mOriginShift / 180.0;
@@ -78,13 +87,41 @@ QGV::GeoRect QGVProjectionEPSG3857::projToGeo(const QRectF& projRect) const
 
 double QGVProjectionEPSG3857::geodesicMeters(const QPointF& projPos1, const QPointF& projPos2) const
 {
-    const QGV::GeoPos geoPos1 = projToGeo(projPos1);
-    const QGV::GeoPos geoPos2 = projToGeo(projPos2);
-    const double latitudeArc = (geoPos1.latitude() - geoPos2.latitude()) * M_PI / 180.0;
-    const double longitudeArc = (geoPos1.longitude() - geoPos2.longitude()) * M_PI / 180.0;
-    const double latitudeH = qPow(sin(latitudeArc * 0.5), 2);
-    const double lontitudeH = qPow(sin(longitudeArc * 0.5), 2);
-    const double lonFactor = cos(geoPos1.latitude() * M_PI / 180.0) * cos(geoPos2.latitude() * M_PI / 180.0);
-    const double arcInRadians = 2.0 * asin(sqrt(latitudeH + lonFactor * lontitudeH));
-    return mEarthRadius * arcInRadians;
+    return haversineMeters(projToGeo(projPos1), projToGeo(projPos2), mEarthRadius);
+}
+
+void QGVProjectionEPSG3857::geoToProjArray(const double* lat,
+                                           const double* lon,
+                                           double* x,
+                                           double* y,
+                                           size_t count) const
+{
+    // separate loops without branches and temporaries to let compiler vectorize them
+    const double xFactor = mOriginShift / 180.0;
+    for (size_t i = 0; i < count; ++i) {
+        x[i] = lon[i] * xFactor;
+    }
+    const double yFactor = -mEarthRadius;
+    const double latFactor = M_PI / 360.0;
+    for (size_t i = 0; i < count; ++i) {
+        const double clamped = std::min(mMaxLatitude, std::max(mMinLatitude, lat[i]));
+        y[i] = yFactor * std::log(std::tan((90.0 + clamped) * latFactor));
+    }
+}
+
+void QGVProjectionEPSG3857::projToGeoArray(const double* x,
+                                           const double* y,
+                                           double* lat,
+                                           double* lon,
+                                           size_t count) const
+{
+    const double lonFactor = 180.0 / mOriginShift;
+    for (size_t i = 0; i < count; ++i) {
+        lon[i] = x[i] * lonFactor;
+    }
+    const double yFactor = -1.0 / mEarthRadius;
+    const double latFactor = 180.0 / M_PI;
+    for (size_t i = 0; i < count; ++i) {
+        lat[i] = latFactor * (2.0 * std::atan(std::exp(y[i] * yFactor)) - M_PI / 2.0);
+    }
 }
@@ -0,0 +1,106 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "QGVProjectionEPSG4326.h"
+
+#include <QtMath>
+
+QGVProjectionEPSG4326::QGVProjectionEPSG4326()
+    : QGVProjection("EPSG4326",
+                    "WGS84 Equirectangular",
+                    "QGVProjection with latitude and longitude used directly as "
+                    "plane coordinates (Plate Carree), scaled to meters on equator. "
+                    "Used by WMS servers and geographic tile grids.")
+{
+    mEarthRadius = 6378137.0; /* meters */
+    mMetersPerDegree = M_PI * mEarthRadius / 180.0;
+    mGeoBoundary = QGV::GeoRect(90, -180, -90, +180);
+    mProjBoundary = geoToProj(mGeoBoundary);
+}
+
+QGV::GeoRect QGVProjectionEPSG4326::boundaryGeoRect() const
+{
+    return mGeoBoundary;
+}
+
+QRectF QGVProjectionEPSG4326::boundaryProjRect() const
+{
+    return mProjBoundary;
+}
+
+bool QGVProjectionEPSG4326::isWrapAround() const
+{
+    return true;
+}
+
+QPointF QGVProjectionEPSG4326::geoToProj(const QGV::GeoPos& geoPos) const
+{
+    return QPointF(geoPos.longitude() * mMetersPerDegree, -geoPos.latitude() * mMetersPerDegree);
+}
+
+QGV::GeoPos QGVProjectionEPSG4326::projToGeo(const QPointF& projPos) const
+{
+    return QGV::GeoPos(-projPos.y() / mMetersPerDegree, projPos.x() / mMetersPerDegree);
+}
+
+QRectF QGVProjectionEPSG4326::geoToProj(const QGV::GeoRect& geoRect) const
+{
+    QRectF rect;
+    rect.setTopLeft(geoToProj(geoRect.topLeft()));
+    rect.setBottomRight(geoToProj(geoRect.bottomRight()));
+    return rect;
+}
+
+QGV::GeoRect QGVProjectionEPSG4326::projToGeo(const QRectF& projRect) const
+{
+    return QGV::GeoRect(projToGeo(projRect.topLeft()), projToGeo(projRect.bottomRight()));
+}
+
+double QGVProjectionEPSG4326::geodesicMeters(const QPointF& projPos1, const QPointF& projPos2) const
+{
+    return haversineMeters(projToGeo(projPos1), projToGeo(projPos2), mEarthRadius);
+}
+
+void QGVProjectionEPSG4326::geoToProjArray(const double* lat,
+                                           const double* lon,
+                                           double* x,
+                                           double* y,
+                                           size_t count) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        x[i] = lon[i] * mMetersPerDegree;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        y[i] = -lat[i] * mMetersPerDegree;
+    }
+}
+
+void QGVProjectionEPSG4326::projToGeoArray(const double* x,
+                                           const double* y,
+                                           double* lat,
+                                           double* lon,
+                                           size_t count) const
+{
+    const double degreesPerMeter = 1.0 / mMetersPerDegree;
+    for (size_t i = 0; i < count; ++i) {
+        lon[i] = x[i] * degreesPerMeter;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        lat[i] = -y[i] * degreesPerMeter;
+    }
+}
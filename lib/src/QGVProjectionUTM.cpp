@@ -0,0 +1,172 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "QGVProjectionUTM.h"
+
+#include <QPolygonF>
+#include <QtMath>
+
+#include <cmath>
+
+namespace {
+const double semiMajorAxis = 6378137.0;
+const double flattening = 1.0 / 298.257223563;
+const double scaleFactor = 0.9996;
+const double falseEasting = 500000.0;
+const double southFalseNorthing = 10000000.0;
+const double zoneHalfWidth = 6.0;
+const double maxLatitude = 89.9;
+const int boundarySamples = 64;
+}
+
+QGVProjectionUTM::QGVProjectionUTM(int zone, bool north)
+    : QGVProjection(QString("EPSG%1").arg((north ? 32600 : 32700) + qBound(1, zone, 60)),
+                    QString("WGS84 UTM zone %1%2").arg(qBound(1, zone, 60)).arg(north ? "N" : "S"),
+                    "Universal Transverse Mercator projection, one zone of "
+                    "6 degrees with conformal and low distortion mapping. "
+                    "Used for topographic maps and local measurements.")
+    , mZone(qBound(1, zone, 60))
+    , mNorth(north)
+{
+    // Krueger series of third order, accuracy is better than millimeter inside zone
+    const double n = flattening / (2.0 - flattening);
+    const double n2 = n * n;
+    const double n3 = n2 * n;
+    mEarthRadius = semiMajorAxis;
+    mCentralMeridian = qDegreesToRadians(mZone * 6.0 - 183.0);
+    mFalseNorthing = (mNorth) ? 0.0 : southFalseNorthing;
+    mScaleA = scaleFactor * semiMajorAxis / (1.0 + n) * (1.0 + n2 / 4.0 + n2 * n2 / 64.0);
+    mN2 = 2.0 * qSqrt(n) / (1.0 + n);
+    mAlpha[0] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0;
+    mAlpha[1] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0;
+    mAlpha[2] = 61.0 * n3 / 240.0;
+    mBeta[0] = n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0;
+    mBeta[1] = n2 / 48.0 + n3 / 15.0;
+    mBeta[2] = 17.0 * n3 / 480.0;
+    mDelta[0] = 2.0 * n - 2.0 * n2 / 3.0 - 2.0 * n3;
+    mDelta[1] = 7.0 * n2 / 3.0 - 8.0 * n3 / 5.0;
+    mDelta[2] = 56.0 * n3 / 15.0;
+
+    const double centralLon = mZone * 6.0 - 183.0;
+    mGeoBoundary = (mNorth) ? QGV::GeoRect(84, centralLon - zoneHalfWidth, 0, centralLon + zoneHalfWidth)
+                            : QGV::GeoRect(0, centralLon - zoneHalfWidth, -80, centralLon + zoneHalfWidth);
+
+    // zone is not a rectangle in projection, so boundary is collected from its edges
+    QPolygonF edges;
+    for (int i = 0; i <= boundarySamples; ++i) {
+        const double lonFactor = static_cast<double>(i) / boundarySamples;
+        const double lon = mGeoBoundary.lonLeft() + lonFactor * (mGeoBoundary.lonRigth() - mGeoBoundary.lonLeft());
+        const double latFactor = static_cast<double>(i) / boundarySamples;
+        const double lat = mGeoBoundary.latBottom() + latFactor * (mGeoBoundary.latTop() - mGeoBoundary.latBottom());
+        edges << geoToProj(QGV::GeoPos(mGeoBoundary.latTop(), lon));
+        edges << geoToProj(QGV::GeoPos(mGeoBoundary.latBottom(), lon));
+        edges << geoToProj(QGV::GeoPos(lat, mGeoBoundary.lonLeft()));
+        edges << geoToProj(QGV::GeoPos(lat, mGeoBoundary.lonRigth()));
+    }
+    mProjBoundary = edges.boundingRect();
+}
+
+int QGVProjectionUTM::getZone() const
+{
+    return mZone;
+}
+
+bool QGVProjectionUTM::isNorth() const
+{
+    return mNorth;
+}
+
+int QGVProjectionUTM::zoneForGeo(const QGV::GeoPos& geoPos)
+{
+    const int zone = static_cast<int>(qFloor((geoPos.longitude() + 180.0) / 6.0)) + 1;
+    return qBound(1, zone, 60);
+}
+
+QGV::GeoRect QGVProjectionUTM::boundaryGeoRect() const
+{
+    return mGeoBoundary;
+}
+
+QRectF QGVProjectionUTM::boundaryProjRect() const
+{
+    return mProjBoundary;
+}
+
+QPointF QGVProjectionUTM::geoToProj(const QGV::GeoPos& geoPos) const
+{
+    const double lat = qDegreesToRadians(qBound(-maxLatitude, geoPos.latitude(), maxLatitude));
+    const double lon = qDegreesToRadians(geoPos.longitude()) - mCentralMeridian;
+    const double sinLat = qSin(lat);
+    const double t = std::sinh(std::atanh(sinLat) - mN2 * std::atanh(mN2 * sinLat));
+    const double xiPrime = qAtan2(t, qCos(lon));
+    const double etaPrime = std::atanh(qSin(lon) / qSqrt(1.0 + t * t));
+    double xi = xiPrime;
+    double eta = etaPrime;
+    for (int j = 1; j <= 3; ++j) {
+        xi += mAlpha[j - 1] * qSin(2.0 * j * xiPrime) * std::cosh(2.0 * j * etaPrime);
+        eta += mAlpha[j - 1] * qCos(2.0 * j * xiPrime) * std::sinh(2.0 * j * etaPrime);
+    }
+    const double easting = falseEasting + mScaleA * eta;
+    const double northing = mFalseNorthing + mScaleA * xi;
+    return QPointF(easting, -northing);
+}
+
+QGV::GeoPos QGVProjectionUTM::projToGeo(const QPointF& projPos) const
+{
+    const double xi = (-projPos.y() - mFalseNorthing) / mScaleA;
+    const double eta = (projPos.x() - falseEasting) / mScaleA;
+    double xiPrime = xi;
+    double etaPrime = eta;
+    for (int j = 1; j <= 3; ++j) {
+        xiPrime -= mBeta[j - 1] * qSin(2.0 * j * xi) * std::cosh(2.0 * j * eta);
+        etaPrime -= mBeta[j - 1] * qCos(2.0 * j * xi) * std::sinh(2.0 * j * eta);
+    }
+    const double chi = qAsin(qSin(xiPrime) / std::cosh(etaPrime));
+    double lat = chi;
+    for (int j = 1; j <= 3; ++j) {
+        lat += mDelta[j - 1] * qSin(2.0 * j * chi);
+    }
+    const double lon = mCentralMeridian + qAtan2(std::sinh(etaPrime), qCos(xiPrime));
+    return QGV::GeoPos(qRadiansToDegrees(lat), qRadiansToDegrees(lon));
+}
+
+QRectF QGVProjectionUTM::geoToProj(const QGV::GeoRect& geoRect) const
+{
+    QPolygonF corners;
+    corners << geoToProj(geoRect.topLeft()) << geoToProj(geoRect.topRight()) << geoToProj(geoRect.bottomLeft())
+            << geoToProj(geoRect.bottomRight());
+    return corners.boundingRect();
+}
+
+QGV::GeoRect QGVProjectionUTM::projToGeo(const QRectF& projRect) const
+{
+    const QGV::GeoPos topLeft = projToGeo(projRect.topLeft());
+    const QGV::GeoPos topRight = projToGeo(projRect.topRight());
+    const QGV::GeoPos bottomLeft = projToGeo(projRect.bottomLeft());
+    const QGV::GeoPos bottomRight = projToGeo(projRect.bottomRight());
+    const double latTop = qMax(topLeft.latitude(), topRight.latitude());
+    const double latBottom = qMin(bottomLeft.latitude(), bottomRight.latitude());
+    const double lonLeft = qMin(topLeft.longitude(), bottomLeft.longitude());
+    const double lonRight = qMax(topRight.longitude(), bottomRight.longitude());
+    return QGV::GeoRect(latTop, lonLeft, latBottom, lonRight);
+}
+
+double QGVProjectionUTM::geodesicMeters(const QPointF& projPos1, const QPointF& projPos2) const
+{
+    return haversineMeters(projToGeo(projPos1), projToGeo(projPos2), mEarthRadius);
+}
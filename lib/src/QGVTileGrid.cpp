@@ -0,0 +1,109 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "QGVTileGrid.h"
+#include "QGVProjectionEPSG3857.h"
+#include "QGVProjectionEPSG4326.h"
+
+#include <QtMath>
+
+namespace {
+const double equatorMeters = 40075016.685578;
+const double mercatorExtent = equatorMeters / 2.0;
+}
+
+QGVTileGrid::QGVTileGrid(QSharedPointer<const QGVProjection> projection,
+                         const QRectF& projExtent,
+                         const QSize& zeroZoomTiles)
+    : mProjection(projection)
+    , mProjExtent(projExtent)
+    , mZeroZoomTiles(zeroZoomTiles)
+{
+    Q_ASSERT(!mProjection.isNull());
+    Q_ASSERT(!mProjExtent.isEmpty() && !mZeroZoomTiles.isEmpty());
+    // zoom levels are aligned by tile size on equator with Web Mercator tiles
+    const double tileMeters = mProjExtent.width() / mZeroZoomTiles.width();
+    mZoomOffset = -qRound(qLn(equatorMeters / tileMeters) * M_LOG2E);
+}
+
+QGVTileGrid QGVTileGrid::mercator()
+{
+    static const QGVTileGrid grid(QSharedPointer<const QGVProjection>(new QGVProjectionEPSG3857()),
+                                  QRectF(QPointF(-mercatorExtent, -mercatorExtent),
+                                         QPointF(mercatorExtent, mercatorExtent)),
+                                  QSize(1, 1));
+    return grid;
+}
+
+QGVTileGrid QGVTileGrid::geographic()
+{
+    static const QGVTileGrid grid(QSharedPointer<const QGVProjection>(new QGVProjectionEPSG4326()),
+                                  QRectF(QPointF(-mercatorExtent, -mercatorExtent / 2.0),
+                                         QPointF(mercatorExtent, mercatorExtent / 2.0)),
+                                  QSize(2, 1));
+    return grid;
+}
+
+QSharedPointer<const QGVProjection> QGVTileGrid::getProjection() const
+{
+    return mProjection;
+}
+
+QRectF QGVTileGrid::getProjExtent() const
+{
+    return mProjExtent;
+}
+
+QSize QGVTileGrid::tilesCount(int zoom) const
+{
+    return QSize(mZeroZoomTiles.width() << zoom, mZeroZoomTiles.height() << zoom);
+}
+
+int QGVTileGrid::zoomOffset() const
+{
+    return mZoomOffset;
+}
+
+QGV::GeoTilePos QGVTileGrid::geoToTilePos(int zoom, const QGV::GeoPos& geoPos) const
+{
+    const QPointF projPos = mProjection->geoToProj(geoPos);
+    const QSize count = tilesCount(zoom);
+    const double x = (projPos.x() - mProjExtent.left()) / mProjExtent.width() * count.width();
+    const double y = (projPos.y() - mProjExtent.top()) / mProjExtent.height() * count.height();
+    return QGV::GeoTilePos(zoom, QPoint(qFloor(x), qFloor(y)));
+}
+
+QRect QGVTileGrid::tilesRect(int zoom, const QGV::GeoRect& geoRect) const
+{
+    if (geoRect.isEmpty()) {
+        return {};
+    }
+    const QPoint topLeft = geoToTilePos(zoom, geoRect.topLeft()).pos();
+    const QPoint bottomRight = geoToTilePos(zoom, geoRect.bottomRight()).pos();
+    return QRect(topLeft, bottomRight).intersected(QRect(QPoint(0, 0), tilesCount(zoom)));
+}
+
+QGV::GeoRect QGVTileGrid::toGeoRect(const QGV::GeoTilePos& tilePos) const
+{
+    const QSize count = tilesCount(tilePos.zoom());
+    const double width = mProjExtent.width() / count.width();
+    const double height = mProjExtent.height() / count.height();
+    const QPointF topLeft(mProjExtent.left() + tilePos.pos().x() * width,
+                          mProjExtent.top() + tilePos.pos().y() * height);
+    return mProjection->projToGeo(QRectF(topLeft, QSizeF(width, height)));
+}
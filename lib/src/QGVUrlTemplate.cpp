@@ -0,0 +1,171 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "QGVUrlTemplate.h"
+
+namespace {
+// expected length of one expanded placeholder, used to allocate url only once
+const int placeholderReserve = 12;
+
+void appendNumber(QString& url, int value)
+{
+    QChar digits[12];
+    int count = 0;
+    unsigned int rest = (value < 0) ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+    do {
+        digits[count++] = QChar(static_cast<ushort>('0' + rest % 10));
+        rest /= 10;
+    } while (rest != 0);
+    if (value < 0) {
+        url.append(QChar('-'));
+    }
+    while (count > 0) {
+        url.append(digits[--count]);
+    }
+}
+
+void appendQuadKey(QString& url, const QGV::GeoTilePos& tilePos)
+{
+    const int x = tilePos.pos().x();
+    const int y = tilePos.pos().y();
+    for (int i = tilePos.zoom(); i > 0; i--) {
+        const int mask = 1 << (i - 1);
+        const int digit = ((x & mask) != 0 ? 1 : 0) + ((y & mask) != 0 ? 2 : 0);
+        url.append(QChar(static_cast<ushort>('0' + digit)));
+    }
+}
+}
+
+QGVUrlTemplate::QGVUrlTemplate()
+    : mReserve(0)
+{
+}
+
+QGVUrlTemplate::QGVUrlTemplate(const QString& url, const QStringList& variables)
+    : mUrl(url)
+    , mReserve(0)
+{
+    for (const QString& variable : variables) {
+        mVariables.append(variable.toLower());
+    }
+
+    int pos = 0;
+    while (pos < url.size()) {
+        const int start = url.indexOf("${", pos);
+        const int end = (start < 0) ? -1 : url.indexOf('}', start + 2);
+        if (end < 0) {
+            append({ Field::Text, url.mid(pos), -1 });
+            break;
+        }
+        if (start > pos) {
+            append({ Field::Text, url.mid(pos, start - pos), -1 });
+        }
+        const QString name = url.mid(start + 2, end - start - 2).toLower();
+        if (name == "z") {
+            append({ Field::Zoom, QString(), -1 });
+        } else if (name == "x") {
+            append({ Field::X, QString(), -1 });
+        } else if (name == "y") {
+            append({ Field::Y, QString(), -1 });
+        } else if (name == "qk") {
+            append({ Field::QuadKey, QString(), -1 });
+        } else if (mVariables.contains(name)) {
+            append({ Field::Variable, QString(), mVariables.indexOf(name) });
+        } else {
+            append({ Field::Text, url.mid(start, end - start + 1), -1 });
+        }
+        pos = end + 1;
+    }
+}
+
+bool QGVUrlTemplate::isEmpty() const
+{
+    return mSegments.isEmpty();
+}
+
+QString QGVUrlTemplate::getUrl() const
+{
+    return mUrl;
+}
+
+/*!
+ * Variable with value which is the same for all tiles (like locale) is replaced by text.
+ */
+void QGVUrlTemplate::bind(const QString& variable, const QString& value)
+{
+    const int index = mVariables.indexOf(variable.toLower());
+    if (index < 0) {
+        return;
+    }
+    const QVector<Segment> segments = mSegments;
+    mSegments.clear();
+    mReserve = 0;
+    for (const Segment& segment : segments) {
+        if (segment.field == Field::Variable && segment.index == index) {
+            append({ Field::Text, value, -1 });
+        } else {
+            append(segment);
+        }
+    }
+}
+
+QString QGVUrlTemplate::toUrl(const QGV::GeoTilePos& tilePos, const QStringList& values) const
+{
+    QString url;
+    url.reserve(mReserve + tilePos.zoom());
+    for (const Segment& segment : mSegments) {
+        switch (segment.field) {
+            case Field::Text:
+                url.append(segment.text);
+                break;
+            case Field::Zoom:
+                appendNumber(url, tilePos.zoom());
+                break;
+            case Field::X:
+                appendNumber(url, tilePos.pos().x());
+                break;
+            case Field::Y:
+                appendNumber(url, tilePos.pos().y());
+                break;
+            case Field::QuadKey:
+                appendQuadKey(url, tilePos);
+                break;
+            case Field::Variable:
+                url.append(values.value(segment.index));
+                break;
+        }
+    }
+    return url;
+}
+
+void QGVUrlTemplate::append(const Segment& segment)
+{
+    if (segment.field == Field::Text) {
+        if (segment.text.isEmpty()) {
+            return;
+        }
+        mReserve += segment.text.size();
+        if (!mSegments.isEmpty() && mSegments.last().field == Field::Text) {
+            mSegments.last().text.append(segment.text);
+            return;
+        }
+    } else {
+        mReserve += placeholderReserve;
+    }
+    mSegments.append(segment);
+}
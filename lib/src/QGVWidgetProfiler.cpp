@@ -0,0 +1,247 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "QGVWidgetProfiler.h"
+#include "QGVDrawItem.h"
+#include "QGVLayer.h"
+#include "QGVLayerTiles.h"
+#include "QGVMapQGItem.h"
+#include "QGVMapQGView.h"
+
+#include <QHBoxLayout>
+#include <QPixmapCache>
+#include <algorithm>
+
+namespace {
+const int defaultUpdateIntervalMs = 500;
+
+const QGVItem* topItem(const QGVItem* item, const QGVItem* root)
+{
+    while (item->getParent() != nullptr && item->getParent() != root) {
+        item = item->getParent();
+    }
+    return item;
+}
+
+QString itemName(const QGVItem* item)
+{
+    auto layer = qobject_cast<const QGVLayer*>(item);
+    if (layer != nullptr && !layer->getName().isEmpty()) {
+        return layer->getName();
+    }
+    return item->metaObject()->className();
+}
+
+QString msText(qint64 us)
+{
+    return QString::number(us / 1000.0, 'f', 1);
+}
+}
+
+QGVWidgetProfiler::QGVWidgetProfiler()
+{
+    mLastFrames = 0;
+    mLastFrameUs = 0;
+    mLabel.reset(new QLabel());
+    mLabel->setAutoFillBackground(true);
+    mLabel->setTextFormat(Qt::PlainText);
+    mLabel->setFont(QFont("monospace"));
+    mLabel->setContentsMargins(4, 4, 4, 4);
+    setAttribute(Qt::WA_TransparentForMouseEvents, true);
+    setAnchor(QPoint(10, 10), { Qt::LeftEdge, Qt::TopEdge });
+    setLayout(new QHBoxLayout(this));
+    layout()->setSpacing(0);
+    layout()->setSizeConstraint(QLayout::SetMinimumSize);
+    layout()->setContentsMargins(0, 0, 0, 0);
+    layout()->addWidget(mLabel.data());
+
+    mTimer.setInterval(defaultUpdateIntervalMs);
+    connect(&mTimer, &QTimer::timeout, this, &QGVWidgetProfiler::updateText);
+}
+
+QGVWidgetProfiler::~QGVWidgetProfiler()
+{
+    setProfiling(false);
+}
+
+void QGVWidgetProfiler::setUpdateInterval(int msec)
+{
+    mTimer.setInterval(qMax(50, msec));
+}
+
+int QGVWidgetProfiler::getUpdateInterval() const
+{
+    return mTimer.interval();
+}
+
+QLabel* QGVWidgetProfiler::label()
+{
+    return mLabel.data();
+}
+
+/*!
+ * Paint time of each layer since last reset, sorted from the most expensive one.
+ */
+QString QGVWidgetProfiler::paintReport() const
+{
+    if (getMap() == nullptr) {
+        return QString();
+    }
+    const QGVPaintStats& stats = getMap()->geoView()->getPaintStats();
+    QList<const QGVItem*> layers;
+    qint64 totalUs = 0;
+    for (int index = 0; index < getMap()->countItems(); ++index) {
+        const QGVItem* layer = getMap()->getItem(index);
+        layers.append(layer);
+        totalUs += stats.layerPaintUs.value(layer, 0);
+    }
+    std::stable_sort(layers.begin(), layers.end(), [&stats](const QGVItem* left, const QGVItem* right) {
+        return stats.layerPaintUs.value(left, 0) > stats.layerPaintUs.value(right, 0);
+    });
+
+    QStringList lines;
+    lines << QString("frames %1, paint %2 ms (avg %3 ms, max %4 ms)")
+                     .arg(stats.frames)
+                     .arg(msText(stats.totalFrameUs))
+                     .arg(msText((stats.frames > 0) ? stats.totalFrameUs / stats.frames : 0))
+                     .arg(msText(stats.maxFrameUs));
+    for (const QGVItem* layer : layers) {
+        const qint64 paintUs = stats.layerPaintUs.value(layer, 0);
+        const qint64 paintCount = stats.layerPaintCount.value(layer, 0);
+        lines << QString("%1: %2 ms in %3 item paints (avg %4 us), %5%")
+                         .arg(itemName(layer))
+                         .arg(msText(paintUs))
+                         .arg(paintCount)
+                         .arg((paintCount > 0) ? paintUs / paintCount : 0)
+                         .arg((totalUs > 0) ? 100 * paintUs / totalUs : 0);
+    }
+    return lines.join("\n");
+}
+
+void QGVWidgetProfiler::dumpPaintReport() const
+{
+    qInfo().noquote() << paintReport();
+}
+
+void QGVWidgetProfiler::resetStats()
+{
+    mLastFrames = 0;
+    mLastFrameUs = 0;
+    mLastLayerPaintUs.clear();
+    if (getMap() != nullptr) {
+        getMap()->geoView()->resetPaintStats();
+    }
+}
+
+void QGVWidgetProfiler::showEvent(QShowEvent* event)
+{
+    QGVWidget::showEvent(event);
+    setProfiling(true);
+    mInterval.start();
+    mTimer.start();
+    updateText();
+}
+
+void QGVWidgetProfiler::hideEvent(QHideEvent* event)
+{
+    QGVWidget::hideEvent(event);
+    mTimer.stop();
+    setProfiling(false);
+}
+
+void QGVWidgetProfiler::setProfiling(bool enabled)
+{
+    if (getMap() != nullptr) {
+        getMap()->geoView()->setPaintProfiling(enabled);
+    }
+}
+
+void QGVWidgetProfiler::updateText()
+{
+    QGVMap* geoMap = getMap();
+    if (geoMap == nullptr) {
+        return;
+    }
+    QGVMapQGView* view = geoMap->geoView();
+    const QGVPaintStats& stats = view->getPaintStats();
+
+    const qint64 elapsedMs = mInterval.restart();
+    const qint64 frames = (stats.frames >= mLastFrames) ? stats.frames - mLastFrames : stats.frames;
+    const qint64 framesUs = (stats.totalFrameUs >= mLastFrameUs) ? stats.totalFrameUs - mLastFrameUs : stats.totalFrameUs;
+    mLastFrames = stats.frames;
+    mLastFrameUs = stats.totalFrameUs;
+    const double fps = (elapsedMs > 0) ? 1000.0 * frames / elapsedMs : 0.0;
+
+    // visible items and estimation of their device coordinate caches
+    const QRect viewportRect = view->viewport()->rect();
+    const QRectF sceneRect = view->mapToScene(viewportRect).boundingRect();
+    const qreal pixelRatio = view->devicePixelRatioF();
+    const QList<QGraphicsItem*> visible = view->scene()->items(sceneRect, Qt::IntersectsItemBoundingRect);
+    QHash<const QGVItem*, int> visibleItems;
+    qint64 cacheBytes = 0;
+    for (QGraphicsItem* item : visible) {
+        const QGVDrawItem* geoObject = QGVMapQGItem::geoObjectFromQGItem(item);
+        if (geoObject == nullptr) {
+            continue;
+        }
+        visibleItems[topItem(geoObject, geoMap->rootItem())] += 1;
+        if (item->cacheMode() == QGraphicsItem::DeviceCoordinateCache) {
+            const QRect deviceRect = view->mapFromScene(item->sceneBoundingRect()).boundingRect() & viewportRect;
+            cacheBytes += static_cast<qint64>(deviceRect.width() * pixelRatio) *
+                          static_cast<qint64>(deviceRect.height() * pixelRatio) * 4;
+        }
+    }
+
+    QStringList lines;
+    lines << QString("frame %1 ms (avg %2, max %3), %4 fps")
+                     .arg(msText(stats.lastFrameUs))
+                     .arg(msText((frames > 0) ? framesUs / frames : 0))
+                     .arg(msText(stats.maxFrameUs))
+                     .arg(fps, 0, 'f', 1);
+    lines << QString("scene items %1, visible %2").arg(view->scene()->items().size()).arg(visible.size());
+
+    // paint time of layers since previous update, stats may be reset in between
+    QHash<const QGVItem*, qint64> layerPaintUs;
+    int pendingTiles = 0;
+    int inFlightTiles = 0;
+    for (int index = 0; index < geoMap->countItems(); ++index) {
+        const QGVItem* layer = geoMap->getItem(index);
+        const qint64 totalUs = stats.layerPaintUs.value(layer, 0);
+        const qint64 lastUs = mLastLayerPaintUs.value(layer, 0);
+        layerPaintUs[layer] = totalUs;
+        QString line = QString("%1: %2 visible, paint %3 ms")
+                               .arg(itemName(layer))
+                               .arg(visibleItems.value(layer, 0))
+                               .arg(msText((totalUs >= lastUs) ? totalUs - lastUs : totalUs));
+        auto tiles = qobject_cast<const QGVLayerTiles*>(layer);
+        if (tiles != nullptr) {
+            const int pending = tiles->countPendingTiles();
+            const int inFlight = tiles->countRequestsInFlight();
+            line += QString(", tiles %1 pending %2 in flight").arg(pending).arg(inFlight);
+            pendingTiles += pending;
+            inFlightTiles += inFlight;
+        }
+        lines << line;
+    }
+    mLastLayerPaintUs = layerPaintUs;
+    lines << QString("tiles %1 pending, %2 in flight").arg(pendingTiles).arg(inFlightTiles);
+    lines << QString("pixmap cache ~%1 of %2 MB")
+                     .arg(cacheBytes / (1024.0 * 1024.0), 0, 'f', 1)
+                     .arg(QPixmapCache::cacheLimit() / 1024);
+    mLabel->setText(lines.join("\n"));
+}
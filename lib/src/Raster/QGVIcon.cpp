@@ -17,6 +17,8 @@
  ****************************************************************************/
 
 #include "Raster/QGVIcon.h"
+#include "Raster/QGVIconRegistry.h"
+#include "Raster/QGVImage.h"
 #include "QGVMap.h"
 
 #include <QPainter>
@@ -45,7 +47,7 @@ void QGVIcon::setGeometry(const QPointF& projPos, const QSizeF& imageSize)
     calculateGeometry();
 }
 
-QImage QGVIcon::getImage() const
+const QImage& QGVIcon::getImage() const
 {
     return mImage;
 }
@@ -64,7 +66,18 @@ void QGVIcon::loadImage(const QByteArray& rawData)
 
 void QGVIcon::loadImage(const QImage& image)
 {
-    mImage = image;
+    mIconKey.clear();
+    mImage = QGVImage::toPaintFormat(image);
+    calculateGeometry();
+}
+
+/*!
+ * Image is taken from QGVIconRegistry and shared with other icons using the same key.
+ */
+void QGVIcon::loadIcon(const QString& key)
+{
+    mIconKey = key;
+    mImage = QGVIconRegistry::instance()->image(key);
     calculateGeometry();
 }
 
@@ -90,7 +103,7 @@ void QGVIcon::projPaint(QPainter* painter)
     QRectF paintRect = mProjRect;
 
     painter->setRenderHint(QPainter::SmoothPixmapTransform);
-    painter->drawImage(paintRect, getImage());
+    painter->drawImage(paintRect, mScaledImage.isNull() ? mImage : mScaledImage);
 }
 
 void QGVIcon::calculateGeometry()
@@ -108,6 +121,12 @@ void QGVIcon::calculateGeometry()
 
     mProjRect = QRectF(mProjPos - baseAnchor, baseSize);
 
+    // shared symbol is pre-scaled to screen pixels once for all icons of the same size
+    mScaledImage = QImage();
+    if (!mIconKey.isEmpty()) {
+        mScaledImage = QGVIconRegistry::instance()->image(mIconKey, baseSize.toSize(), getMap()->devicePixelRatioF());
+    }
+
     resetBoundary();
     refresh();
 }
@@ -0,0 +1,137 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "Raster/QGVIconRegistry.h"
+#include "Raster/QGVImage.h"
+
+namespace {
+const int scaledMemoryKb = 16 * 1024;
+}
+
+QGVIconRegistry::QGVIconRegistry()
+{
+    mScaled.setMaxCost(scaledMemoryKb);
+}
+
+QGVIconRegistry* QGVIconRegistry::instance()
+{
+    static QGVIconRegistry registry;
+    return &registry;
+}
+
+/*!
+ * Symbol is decoded only if key is not registered yet.
+ */
+QImage QGVIconRegistry::add(const QString& key, const QByteArray& rawData)
+{
+    {
+        QReadLocker locker(&mLock);
+        const auto it = mImages.constFind(key);
+        if (it != mImages.constEnd()) {
+            return it.value();
+        }
+    }
+    // decoding is done without lock, so other threads are not blocked
+    return add(key, QImage::fromData(rawData));
+}
+
+QImage QGVIconRegistry::add(const QString& key, const QImage& image)
+{
+    if (image.isNull()) {
+        qgvWarning() << "icon is empty" << key;
+        return image;
+    }
+    const QImage prepared = QGVImage::toPaintFormat(image);
+    QWriteLocker locker(&mLock);
+    const auto it = mImages.constFind(key);
+    if (it != mImages.constEnd()) {
+        return it.value();
+    }
+    mImages.insert(key, prepared);
+    return prepared;
+}
+
+void QGVIconRegistry::remove(const QString& key)
+{
+    QWriteLocker locker(&mLock);
+    mImages.remove(key);
+    QMutexLocker scaledLocker(&mScaledLock);
+    const QString prefix = key + '\n';
+    for (const QString& variantKey : mScaled.keys()) {
+        if (variantKey.startsWith(prefix)) {
+            mScaled.remove(variantKey);
+        }
+    }
+}
+
+void QGVIconRegistry::clear()
+{
+    QWriteLocker locker(&mLock);
+    mImages.clear();
+    QMutexLocker scaledLocker(&mScaledLock);
+    mScaled.clear();
+}
+
+bool QGVIconRegistry::contains(const QString& key) const
+{
+    QReadLocker locker(&mLock);
+    return mImages.contains(key);
+}
+
+QImage QGVIconRegistry::image(const QString& key) const
+{
+    QReadLocker locker(&mLock);
+    return mImages.value(key);
+}
+
+/*!
+ * Symbol scaled to given size in device independent pixels, so it is painted without scaling.
+ */
+QImage QGVIconRegistry::image(const QString& key, const QSize& size, double devicePixelRatio) const
+{
+    const QSize pixelSize = (QSizeF(size) * devicePixelRatio).toSize();
+    const QString variantKey = scaledKey(key, pixelSize);
+    QImage original;
+    {
+        QReadLocker locker(&mLock);
+        original = mImages.value(key);
+        if (original.isNull() || pixelSize.isEmpty() || original.size() == pixelSize) {
+            return original;
+        }
+        // cache updates its usage order on lookup, so it has own lock
+        QMutexLocker scaledLocker(&mScaledLock);
+        const QImage* cached = mScaled.object(variantKey);
+        if (cached != nullptr) {
+            return *cached;
+        }
+    }
+    const QImage scaled = original.scaled(pixelSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    QReadLocker locker(&mLock);
+    if (!mImages.contains(key)) {
+        return scaled;
+    }
+    QMutexLocker scaledLocker(&mScaledLock);
+    mScaled.insert(variantKey, new QImage(scaled), qMax(1, static_cast<int>(scaled.sizeInBytes() / 1024)));
+    return scaled;
+}
+
+QString QGVIconRegistry::scaledKey(const QString& key, const QSize& pixelSize)
+{
+    // line break is not expected in keys (urls, file names), so variants of different keys are not mixed
+    return key + '\n' + QString::number(pixelSize.width()) + 'x' + QString::number(pixelSize.height());
+}
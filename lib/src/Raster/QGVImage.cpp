@@ -18,18 +18,32 @@
 
 #include "Raster/QGVImage.h"
 #include "QGVMap.h"
+#include "QGVMetrics.h"
 
+#include <QBuffer>
+#include <QImageReader>
 #include <QPainter>
 
+namespace {
+const int meshCells = 8;
+}
+
 QGVImage::QGVImage()
     : mCeilingOnScale{ true }
+    , mOpaque{ false }
 {
 }
 
 void QGVImage::setGeometry(const QGV::GeoRect& geoRect)
+{
+    setGeometry(geoRect, QSharedPointer<const QGVProjection>());
+}
+
+void QGVImage::setGeometry(const QGV::GeoRect& geoRect, QSharedPointer<const QGVProjection> imageProjection)
 {
     mGeoRect = geoRect;
     mProjRect = {};
+    mImageProjection = imageProjection;
     calculateGeometry();
 }
 
@@ -37,10 +51,11 @@ void QGVImage::setGeometry(const QRectF& projRect)
 {
     mGeoRect = {};
     mProjRect = projRect;
+    mImageProjection.reset();
     calculateGeometry();
 }
 
-QImage QGVImage::getImage() const
+const QImage& QGVImage::getImage() const
 {
     return mImage;
 }
@@ -52,14 +67,31 @@ bool QGVImage::isImage() const
 
 void QGVImage::loadImage(const QByteArray& rawData)
 {
+    // buffer shares data with caller, bytes are not copied
+    QBuffer buffer;
+    buffer.setData(rawData);
+    buffer.open(QIODevice::ReadOnly);
+    loadImage(&buffer);
+}
+
+/*!
+ * Image is decoded directly from device (like network reply) without intermediate buffer.
+ * Format is a hint to skip detection by content.
+ */
+void QGVImage::loadImage(QIODevice* device, const QByteArray& format)
+{
+    QGVMetrics::Scope scope(QGVMetrics::Stage::Decode);
+    QImageReader reader(device, format);
     QImage image;
-    image.loadFromData(rawData);
+    if (!reader.read(&image)) {
+        qgvWarning() << "image decoding failed" << reader.errorString();
+    }
     loadImage(image);
 }
 
 void QGVImage::loadImage(const QImage& image)
 {
-    mImage = image;
+    mImage = toPaintFormat(image, mOpaque);
     calculateGeometry();
 }
 
@@ -68,10 +100,65 @@ void QGVImage::setCeilingOnScale(bool enabled)
     mCeilingOnScale = enabled;
 }
 
+/*!
+ * Opaque image drops alpha channel (useful for base tiles), so painting is a plain copy of pixels.
+ */
+void QGVImage::setOpaque(bool opaque)
+{
+    if (mOpaque == opaque) {
+        return;
+    }
+    mOpaque = opaque;
+    if (!mImage.isNull()) {
+        mImage = toPaintFormat(mImage, mOpaque);
+        refresh();
+    }
+}
+
+bool QGVImage::isOpaque() const
+{
+    return mOpaque;
+}
+
+/*!
+ * Image converted to format which is painted without conversion (RGB32 or ARGB32_Premultiplied).
+ * Conversion is made once on load instead of on each paint. Can be called from any thread.
+ */
+QImage QGVImage::toPaintFormat(const QImage& image, bool opaque)
+{
+    if (image.isNull()) {
+        return image;
+    }
+    const QImage::Format format = (opaque || !image.hasAlphaChannel()) ? QImage::Format_RGB32
+                                                                       : QImage::Format_ARGB32_Premultiplied;
+    if (image.format() == format) {
+        return image;
+    }
+    return image.convertToFormat(format);
+}
+
+void QGVImage::onProjectionPrepare(const QGVProjection* projection)
+{
+    QGVDrawItem::onProjectionPrepare(projection);
+    calculateProjection(projection);
+}
+
+int QGVImage::projectionCost() const
+{
+    // corners of rect, plus mesh nodes when image is reprojected
+    const bool mesh = !mImageProjection.isNull() && !mImage.isNull();
+    return 2 + (mesh ? (meshCells + 1) * (meshCells + 1) : 0);
+}
+
 void QGVImage::onProjection(QGVMap* geoMap)
 {
     QGVDrawItem::onProjection(geoMap);
-    calculateGeometry();
+    if (isProjectionPrepared()) {
+        resetBoundary();
+        refresh();
+    } else {
+        calculateGeometry();
+    }
 }
 
 QPainterPath QGVImage::projShape() const
@@ -95,7 +182,18 @@ void QGVImage::projPaint(QPainter* painter)
     }
 
     painter->setRenderHint(QPainter::SmoothPixmapTransform);
-    painter->drawImage(paintRect, getImage());
+
+    if (!mMesh.isEmpty()) {
+        for (const MeshCell& cell : mMesh) {
+            painter->save();
+            painter->setTransform(cell.transform, true);
+            painter->drawImage(cell.imageRect, mImage, cell.imageRect);
+            painter->restore();
+        }
+        return;
+    }
+
+    painter->drawImage(paintRect, mImage);
 }
 
 void QGVImage::calculateGeometry()
@@ -104,10 +202,60 @@ void QGVImage::calculateGeometry()
         return;
     }
 
-    if (!mGeoRect.isEmpty()) {
-        mProjRect = getMap()->getProjection()->geoToProj(mGeoRect);
-    }
+    calculateProjection(getMap()->getProjection());
 
     resetBoundary();
     refresh();
 }
+
+void QGVImage::calculateProjection(const QGVProjection* projection)
+{
+    if (!mGeoRect.isEmpty()) {
+        mProjRect = projection->geoToProj(mGeoRect);
+    }
+    calculateMesh(projection);
+}
+
+void QGVImage::calculateMesh(const QGVProjection* projection)
+{
+    mMesh.clear();
+
+    if (mImageProjection.isNull() || mImage.isNull() || mGeoRect.isEmpty() ||
+        mImageProjection->getID() == projection->getID()) {
+        return;
+    }
+
+    // image is linear in own projection, so it is warped by grid of cells with affine-like transformation per
+    // cell. Nodes are calculated once per projection change instead of per pixel on each paint.
+    const QRectF imageProjRect = mImageProjection->geoToProj(mGeoRect);
+    QVector<QPointF> nodes;
+    nodes.reserve((meshCells + 1) * (meshCells + 1));
+    for (int row = 0; row <= meshCells; ++row) {
+        for (int col = 0; col <= meshCells; ++col) {
+            const QPointF imageProjPos(imageProjRect.left() + imageProjRect.width() * col / meshCells,
+                                       imageProjRect.top() + imageProjRect.height() * row / meshCells);
+            nodes.append(projection->geoToProj(mImageProjection->projToGeo(imageProjPos)));
+        }
+    }
+    mProjRect = QPolygonF(nodes).boundingRect();
+
+    const double cellWidth = static_cast<double>(mImage.width()) / meshCells;
+    const double cellHeight = static_cast<double>(mImage.height()) / meshCells;
+    mMesh.reserve(meshCells * meshCells);
+    for (int row = 0; row < meshCells; ++row) {
+        for (int col = 0; col < meshCells; ++col) {
+            const QRectF imageRect(col * cellWidth, row * cellHeight, cellWidth, cellHeight);
+            QPolygonF imageQuad;
+            imageQuad << imageRect.topLeft() << imageRect.topRight() << imageRect.bottomRight()
+                      << imageRect.bottomLeft();
+            const int index = row * (meshCells + 1) + col;
+            QPolygonF projQuad;
+            projQuad << nodes[index] << nodes[index + 1] << nodes[index + meshCells + 2]
+                     << nodes[index + meshCells + 1];
+            QTransform transform;
+            if (QTransform::quadToQuad(imageQuad, projQuad, transform)) {
+                mMesh.append({ imageRect, transform });
+            }
+        }
+    }
+}
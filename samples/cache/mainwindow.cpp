@@ -24,6 +24,7 @@
 #include <rectangle.h>
 
 #include <QGeoView/QGVLayerOSM.h>
+#include <QGeoView/QGVLayerTilesOnlineDownload.h>
 
 MainWindow::MainWindow()
 {
@@ -37,13 +38,22 @@ MainWindow::MainWindow()
 
     // Background layer
     auto osmLayer = new QGVLayerOSM();
-    // load piece of map for specified zoom & geo coord
-    //osmLayer->loadTilesFromGeo(QGV::GeoRect(56.023097, 92.874172, 55.532730, 94.078502), 5);
-    osmLayer->loadTilesFromGeo(QGV::GeoRect(48.638398, 81.112342, 6.780717, -163.223596), 4);
-
+    // download piece of map for specified zoom range & geo coord to the cache.
+    // tiles which are already in cache are skipped, so interrupted download is continued on next run.
+    auto download = new QGVLayerTilesOnlineDownload(osmLayer, this);
+    download->setArea(QGV::GeoRect(56.023097, 92.874172, 55.532730, 94.078502), 4, 8);
+    download->setMaxParallel(4);
+    qgvDebug() << "download estimate" << download->estimateTiles() << "tiles" << download->estimateBytes() << "bytes";
+    connect(download, &QGVLayerTilesOnlineDownload::progress, this, [this](qint64 processed, qint64 total) {
+        setWindowTitle(QString("QGeoView Samples - 10000 elements & cache (%1/%2)").arg(processed).arg(total));
+    });
+    connect(download, &QGVLayerTilesOnlineDownload::finished, download, &QObject::deleteLater);
+    // set offline mode when area is downloaded, download is paused while layer is offline
+    connect(download, &QGVLayerTilesOnlineDownload::finished, osmLayer, [osmLayer]() { osmLayer->setOffline(true); });
+    download->start();
 
-    // set offline mode
-    osmLayer->setOffline(true);
+    // show downloaded tiles upscaled when zoom is above downloaded levels
+    osmLayer->setOverzoomLevels(4);
     mMap->addItem(osmLayer);
 
     // 10000 layer
@@ -19,6 +19,7 @@
 #include "mainwindow.h"
 
 #include <QCheckBox>
+#include <QPushButton>
 #include <QTimer>
 #include <QVBoxLayout>
 
@@ -46,6 +47,8 @@ MainWindow::MainWindow()
     mMap->addWidget(new QGVWidgetCompass());
     mMap->addWidget(new QGVWidgetZoom());
     mMap->addWidget(new QGVWidgetScale());
+    mProfiler = new QGVWidgetProfiler();
+    mMap->addWidget(mProfiler);
 
     // Background layer
     auto osmLayer = new QGVLayerOSM();
@@ -111,5 +114,24 @@ QGroupBox* MainWindow::createOptionsList()
         checkButton->setChecked(true);
     }
 
+    {
+        QCheckBox* checkButton = new QCheckBox("Show profiler overlay");
+        groupBox->layout()->addWidget(checkButton);
+
+        connect(checkButton, &QCheckBox::toggled, this, [this](const bool checked) { mProfiler->setVisible(checked); });
+
+        checkButton->setChecked(true);
+    }
+
+    {
+        QPushButton* button = new QPushButton("Dump paint time per layer");
+        groupBox->layout()->addWidget(button);
+
+        connect(button, &QPushButton::clicked, this, [this]() {
+            mProfiler->dumpPaintReport();
+            mProfiler->resetStats();
+        });
+    }
+
     return groupBox;
 }
@@ -23,6 +23,7 @@
 
 #include <QGeoView/QGVLayer.h>
 #include <QGeoView/QGVMap.h>
+#include <QGeoView/QGVWidgetProfiler.h>
 
 class MainWindow : public QMainWindow
 {
@@ -39,4 +40,5 @@ public:
 private:
     QGVMap* mMap;
     QGVLayer* mItemsLayer;
+    QGVWidgetProfiler* mProfiler;
 };
@@ -18,6 +18,8 @@
 
 #include "placemark.h"
 
+#include <QGeoView/Raster/QGVIconRegistry.h>
+#include <QHash>
 #include <QNetworkReply>
 
 Placemark::Placemark(const QGV::GeoPos& geoPos)
@@ -31,26 +33,43 @@ Placemark::Placemark(const QGV::GeoPos& geoPos)
 
 void Placemark::load(const QUrl& url)
 {
-    QNetworkRequest request(url);
-    request.setRawHeader("User-Agent",
-                         "Mozilla/5.0 (Windows; U; MSIE "
-                         "6.0; Windows NT 5.1; SV1; .NET "
-                         "CLR 2.0.50727)");
-    request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
-    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+    // symbol is decoded once and shared by all placemarks
+    const QString key = url.toString();
+    if (QGVIconRegistry::instance()->contains(key)) {
+        loadIcon(key);
+        return;
+    }
 
-    QNetworkReply* reply = QGV::getNetworkManager()->get(request);
-    connect(reply, &QNetworkReply::finished, reply, [reply, this]() {
-        if (reply->error() != QNetworkReply::NoError) {
-            qgvCritical() << "ERROR" << reply->errorString();
+    // placemarks with same symbol wait for one download
+    static QHash<QString, QNetworkReply*> pending;
+    QNetworkReply* reply = pending.value(key, nullptr);
+    if (reply == nullptr) {
+        QNetworkRequest request(url);
+        request.setRawHeader("User-Agent",
+                             "Mozilla/5.0 (Windows; U; MSIE "
+                             "6.0; Windows NT 5.1; SV1; .NET "
+                             "CLR 2.0.50727)");
+        request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+        request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+
+        reply = QGV::getNetworkManager()->get(request);
+        pending.insert(key, reply);
+        connect(reply, &QNetworkReply::finished, reply, [reply, key]() {
+            pending.remove(key);
             reply->deleteLater();
-            return;
+            if (reply->error() != QNetworkReply::NoError) {
+                qgvCritical() << "ERROR" << reply->errorString();
+                return;
+            }
+            QGVIconRegistry::instance()->add(key, reply->readAll());
+        });
+        qgvDebug() << "request" << url;
+    }
+    connect(reply, &QNetworkReply::finished, this, [key, this]() {
+        if (QGVIconRegistry::instance()->contains(key)) {
+            loadIcon(key);
         }
-        loadImage(reply->readAll());
-        reply->deleteLater();
     });
-
-    qgvDebug() << "request" << url;
 }
 
 QTransform Placemark::projTransform() const
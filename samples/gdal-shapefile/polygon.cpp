@@ -44,12 +44,41 @@ PointList Polygon::getPoints() const
     return mGeoPoints;
 }
 
+void Polygon::onProjectionPrepare(const QGVProjection* projection)
+{
+    // Called from worker thread when map projection is changed, only own data can be used here
+    QGVDrawItem::onProjectionPrepare(projection);
+    projectPoints(projection);
+}
+
+int Polygon::projectionCost() const
+{
+    return mGeoPoints.size();
+}
+
 void Polygon::onProjection(QGVMap* geoMap)
 {
     QGVDrawItem::onProjection(geoMap);
-    mProjPoints.clear();
-    for (const QGV::GeoPos& pos : mGeoPoints)
-        mProjPoints << geoMap->getProjection()->geoToProj(pos);
+    if (!isProjectionPrepared())
+        projectPoints(geoMap->getProjection());
+}
+
+void Polygon::projectPoints(const QGVProjection* projection)
+{
+    const int count = mGeoPoints.size();
+    QVector<double> lat(count);
+    QVector<double> lon(count);
+    QVector<double> x(count);
+    QVector<double> y(count);
+    for (int i = 0; i < count; ++i) {
+        lat[i] = mGeoPoints[i].latitude();
+        lon[i] = mGeoPoints[i].longitude();
+    }
+    projection->geoToProjArray(lat.constData(), lon.constData(), x.data(), y.data(), count);
+    mProjPoints.resize(count);
+    for (int i = 0; i < count; ++i) {
+        mProjPoints[i] = QPointF(x[i], y[i]);
+    }
 }
 
 QPainterPath Polygon::projShape() const
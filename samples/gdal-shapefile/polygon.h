@@ -36,6 +36,8 @@ public:
     PointList getPoints() const;
 
 private:
+    void onProjectionPrepare(const QGVProjection* projection) override;
+    int projectionCost() const override;
     void onProjection(QGVMap* geoMap) override;
     QPainterPath projShape() const override;
     void projPaint(QPainter* painter) override;
@@ -47,6 +49,7 @@ private:
     void projOnObjectStartMove(const QPointF& projPos) override;
     void projOnObjectMovePos(const QPointF& projPos) override;
     void projOnObjectStopMove(const QPointF& projPos) override;
+    void projectPoints(const QGVProjection* projection);
 
 private:
     PointList mGeoPoints;
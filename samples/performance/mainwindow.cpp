@@ -120,6 +120,23 @@ QGroupBox* MainWindow::createOptionsList()
      * lead to high load on scene, especially when network had low latency and tiles from low levels are consistently
      * upscaled. VisibleZoomLayersBelowCurrent, VisibleZoomLayersAboveCurrent are limiting QGVLayerTiles to keep only
      * given number of zoom levels above or below current one. When is equals to 0 then only current level is allowed.
+     *
+     * PrefetchTrajectory, PrefetchVelocity are enabling low priority loading of tiles which will be needed soon.
+     * First uses known path of animation (flyTo method), including overview zoom in the middle of flight, and second
+     * extrapolates current speed of map movement by PrefetchLookaheadMs. PrefetchMaxTiles limits number of tiles
+     * prefetched at once. Prefetched tiles are kept in memory and shown immediately when requested, so with
+     * PrefetchTrajectory enabled layer will process camera during animation even if CameraUpdatesDuringAnimation is
+     * disabled.
+     *
+     * ParentPlaceholders is enabling placeholders for missing tiles which are cropped from already decoded tiles of
+     * lower zoom levels. Placeholder is shown immediately and replaced by real tile when it arrives, so tiles of
+     * lower levels are deleted right after zoom change and scene keeps only one level of tiles.
+     *
+     * OverzoomLevels is allowing layer to show tiles above maximal zoom level of tiles provider. Such tiles are cropped
+     * from deepest available tile in memory or in cache and no network requests are made for them.
+     *
+     * OpaqueTiles is dropping alpha channel of tiles once on load, so every repaint of base map is a plain copy of
+     * pixels. Should be used only for base layer without transparent areas.
      */
 
     QGroupBox* groupBox = new QGroupBox(tr("Profiles"));
@@ -184,7 +201,7 @@ QGroupBox* MainWindow::createOptionsList()
 
         QLabel* description = new QLabel();
         description->setText("Set of parameters which gives best performance. This setup will produce 'gray' areas "
-                             "every time during animation and camera actions.");
+                             "every time during camera actions, animation relies on prefetched tiles only.");
 
         QWidget* item = new QWidget();
         item->setLayout(new QVBoxLayout());
@@ -225,6 +242,10 @@ void MainWindow::setupProfileLook()
     mBackground->setVisibleZoomLayersBelowCurrent(10);
     mBackground->setVisibleZoomLayersAboveCurrent(10);
     mBackground->setCameraUpdatesDuringAnimation(true);
+    mBackground->setPrefetchTrajectory(true);
+    mBackground->setPrefetchVelocity(true);
+    mBackground->setParentPlaceholders(false);
+    mBackground->setOpaqueTiles(false);
 }
 
 void MainWindow::setupProfileBalance()
@@ -235,6 +256,10 @@ void MainWindow::setupProfileBalance()
     mBackground->setVisibleZoomLayersBelowCurrent(1);
     mBackground->setVisibleZoomLayersAboveCurrent(3);
     mBackground->setCameraUpdatesDuringAnimation(true);
+    mBackground->setPrefetchTrajectory(true);
+    mBackground->setPrefetchVelocity(true);
+    mBackground->setParentPlaceholders(true);
+    mBackground->setOpaqueTiles(true);
 }
 
 void MainWindow::setupProfileFast()
@@ -245,4 +270,8 @@ void MainWindow::setupProfileFast()
     mBackground->setVisibleZoomLayersBelowCurrent(1);
     mBackground->setVisibleZoomLayersAboveCurrent(1);
     mBackground->setCameraUpdatesDuringAnimation(false);
+    mBackground->setPrefetchTrajectory(true);
+    mBackground->setPrefetchVelocity(false);
+    mBackground->setParentPlaceholders(true);
+    mBackground->setOpaqueTiles(true);
 }
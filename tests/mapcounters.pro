@@ -0,0 +1,7 @@
+TARGET = qgeoview-tests-mapcounters
+TEMPLATE = app
+
+include(tests.pri)
+
+SOURCES += \
+    tst_mapcounters.cpp
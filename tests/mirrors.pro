@@ -0,0 +1,11 @@
+TARGET = qgeoview-tests-mirrors
+TEMPLATE = app
+
+include(tests.pri)
+
+SOURCES += \
+    stubserver.cpp \
+    tst_mirrors.cpp
+
+HEADERS += \
+    stubserver.h
@@ -0,0 +1,110 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "stubserver.h"
+
+#include <QBuffer>
+#include <QImage>
+#include <QTcpSocket>
+#include <QTimer>
+
+StubServer::StubServer(QObject* parent)
+    : QObject(parent)
+{
+    mDelayMs = 0;
+    mStatus = 200;
+    mRequests = 0;
+
+    QImage image(256, 256, QImage::Format_RGB32);
+    image.fill(Qt::gray);
+    QBuffer buffer(&mImage);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "PNG");
+
+    connect(&mServer, &QTcpServer::newConnection, this, &StubServer::onNewConnection);
+}
+
+bool StubServer::listen()
+{
+    return mServer.listen(QHostAddress::LocalHost);
+}
+
+QString StubServer::baseUrl() const
+{
+    return QString("http://127.0.0.1:%1").arg(mServer.serverPort());
+}
+
+void StubServer::setDelayMs(int delayMs)
+{
+    mDelayMs = delayMs;
+}
+
+void StubServer::setStatus(int status)
+{
+    mStatus = status;
+}
+
+int StubServer::requests() const
+{
+    return mRequests;
+}
+
+void StubServer::resetRequests()
+{
+    mRequests = 0;
+}
+
+void StubServer::onNewConnection()
+{
+    while (mServer.hasPendingConnections()) {
+        QTcpSocket* socket = mServer.nextPendingConnection();
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            mBuffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void StubServer::onReadyRead(QTcpSocket* socket)
+{
+    QByteArray& buffer = mBuffers[socket];
+    buffer += socket->readAll();
+    // tile requests are GET without body, so each request ends with empty line
+    int end = buffer.indexOf("\r\n\r\n");
+    while (end >= 0) {
+        buffer.remove(0, end + 4);
+        mRequests++;
+        // equal delay for all requests keeps order of replies on keep-alive connection
+        QTimer::singleShot(mDelayMs, socket, [this, socket]() { sendReply(socket); });
+        end = buffer.indexOf("\r\n\r\n");
+    }
+}
+
+void StubServer::sendReply(QTcpSocket* socket)
+{
+    const bool ok = (mStatus == 200);
+    const QByteArray body = ok ? mImage : QByteArray("error");
+    QByteArray reply;
+    reply += QString("HTTP/1.1 %1 %2\r\n").arg(mStatus).arg(ok ? "OK" : "Error").toLatin1();
+    reply += ok ? "Content-Type: image/png\r\n" : "Content-Type: text/plain\r\n";
+    reply += QString("Content-Length: %1\r\n").arg(body.size()).toLatin1();
+    reply += "Connection: keep-alive\r\n\r\n";
+    reply += body;
+    socket->write(reply);
+}
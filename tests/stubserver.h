@@ -0,0 +1,59 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QTcpServer>
+
+class QTcpSocket;
+
+/*!
+ * Local HTTP/1.1 tile server which answers every GET with the same PNG image or with error status.
+ * Keep-alive connections are supported, replies can be delayed to emulate slow host.
+ */
+class StubServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StubServer(QObject* parent = nullptr);
+
+    bool listen();
+    QString baseUrl() const;
+
+    void setDelayMs(int delayMs);
+    void setStatus(int status);
+
+    int requests() const;
+    void resetRequests();
+
+private:
+    void onNewConnection();
+    void onReadyRead(QTcpSocket* socket);
+    void sendReply(QTcpSocket* socket);
+
+private:
+    QTcpServer mServer;
+    QHash<QTcpSocket*, QByteArray> mBuffers;
+    QByteArray mImage;
+    int mDelayMs;
+    int mStatus;
+    int mRequests;
+};
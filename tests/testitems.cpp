@@ -0,0 +1,162 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "testitems.h"
+
+#include <QPainter>
+
+QAtomicInt TestRect::mShapeCalls;
+
+TestRect::TestRect(const QGV::GeoRect& geoRect)
+    : mGeoRect(geoRect)
+{
+}
+
+int TestRect::shapeCalls()
+{
+    return mShapeCalls.loadAcquire();
+}
+
+void TestRect::resetShapeCalls()
+{
+    mShapeCalls.storeRelease(0);
+}
+
+void TestRect::onProjection(QGVMap* geoMap)
+{
+    QGVDrawItem::onProjection(geoMap);
+    mProjRect = geoMap->getProjection()->geoToProj(mGeoRect);
+}
+
+QPainterPath TestRect::projShape() const
+{
+    // projection of items may be prepared by several threads
+    mShapeCalls.ref();
+    QPainterPath path;
+    path.addRect(mProjRect);
+    return path;
+}
+
+void TestRect::projPaint(QPainter* painter)
+{
+    QPen pen = QPen(QBrush(Qt::black), 1);
+    pen.setCosmetic(true);
+    painter->setPen(pen);
+    painter->setBrush(QBrush(Qt::red));
+    painter->drawRect(mProjRect);
+}
+
+TestTile::TestTile(const QGV::GeoTilePos& tilePos)
+    : mTilePos(tilePos)
+{
+}
+
+void TestTile::onProjection(QGVMap* geoMap)
+{
+    QGVDrawItem::onProjection(geoMap);
+    mProjRect = geoMap->getProjection()->geoToProj(mTilePos.toGeoRect());
+}
+
+QPainterPath TestTile::projShape() const
+{
+    QPainterPath path;
+    path.addRect(mProjRect);
+    return path;
+}
+
+void TestTile::projPaint(QPainter* painter)
+{
+    painter->fillRect(mProjRect, Qt::lightGray);
+}
+
+TestTiles::TestTiles()
+{
+    mRequests = 0;
+    mCancels = 0;
+}
+
+int TestTiles::requests() const
+{
+    return mRequests;
+}
+
+int TestTiles::cancels() const
+{
+    return mCancels;
+}
+
+void TestTiles::resetCounters()
+{
+    mRequests = 0;
+    mCancels = 0;
+}
+
+int TestTiles::minZoomlevel() const
+{
+    return 0;
+}
+
+int TestTiles::maxZoomlevel() const
+{
+    return 19;
+}
+
+void TestTiles::request(const QGV::GeoTilePos& tilePos)
+{
+    mRequests++;
+    onTile(tilePos, new TestTile(tilePos));
+}
+
+void TestTiles::cancel(const QGV::GeoTilePos& /*tilePos*/)
+{
+    mCancels++;
+}
+
+TestMirrorTiles::TestMirrorTiles(const QStringList& baseUrls)
+    : mBaseUrls(baseUrls)
+{
+}
+
+int TestMirrorTiles::minZoomlevel() const
+{
+    return 0;
+}
+
+int TestMirrorTiles::maxZoomlevel() const
+{
+    return 19;
+}
+
+QString TestMirrorTiles::tilePosToUrl(const QGV::GeoTilePos& tilePos) const
+{
+    return tilePosToMirrorUrl(tilePos, 0);
+}
+
+int TestMirrorTiles::mirrorsCount() const
+{
+    return mBaseUrls.size();
+}
+
+QString TestMirrorTiles::tilePosToMirrorUrl(const QGV::GeoTilePos& tilePos, int mirror) const
+{
+    return QString("%1/%2/%3/%4.png")
+            .arg(mBaseUrls.value(mirror))
+            .arg(tilePos.zoom())
+            .arg(tilePos.pos().x())
+            .arg(tilePos.pos().y());
+}
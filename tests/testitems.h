@@ -0,0 +1,104 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#pragma once
+
+#include <QGeoView/QGVDrawItem.h>
+#include <QGeoView/QGVLayerTiles.h>
+#include <QGeoView/QGVLayerTilesOnline.h>
+
+#include <QAtomicInt>
+
+/*!
+ * Rectangle which counts calls of projShape(), counter is shared by all instances.
+ */
+class TestRect : public QGVDrawItem
+{
+public:
+    explicit TestRect(const QGV::GeoRect& geoRect);
+
+    static int shapeCalls();
+    static void resetShapeCalls();
+
+protected:
+    void onProjection(QGVMap* geoMap) override;
+    QPainterPath projShape() const override;
+    void projPaint(QPainter* painter) override;
+
+private:
+    static QAtomicInt mShapeCalls;
+    QGV::GeoRect mGeoRect;
+    QRectF mProjRect;
+};
+
+class TestTile : public QGVDrawItem
+{
+public:
+    explicit TestTile(const QGV::GeoTilePos& tilePos);
+
+protected:
+    void onProjection(QGVMap* geoMap) override;
+    QPainterPath projShape() const override;
+    void projPaint(QPainter* painter) override;
+
+private:
+    QGV::GeoTilePos mTilePos;
+    QRectF mProjRect;
+};
+
+/*!
+ * Tile layer which answers every request immediately with TestTile, like custom-tiles sample does.
+ */
+class TestTiles : public QGVLayerTiles
+{
+public:
+    TestTiles();
+
+    int requests() const;
+    int cancels() const;
+    void resetCounters();
+
+protected:
+    int minZoomlevel() const override;
+    int maxZoomlevel() const override;
+    void request(const QGV::GeoTilePos& tilePos) override;
+    void cancel(const QGV::GeoTilePos& tilePos) override;
+
+private:
+    int mRequests;
+    int mCancels;
+};
+
+/*!
+ * Online layer which spreads tiles over given servers, first server is used when mirrors are disabled.
+ */
+class TestMirrorTiles : public QGVLayerTilesOnline
+{
+public:
+    explicit TestMirrorTiles(const QStringList& baseUrls);
+
+protected:
+    int minZoomlevel() const override;
+    int maxZoomlevel() const override;
+    QString tilePosToUrl(const QGV::GeoTilePos& tilePos) const override;
+    int mirrorsCount() const override;
+    QString tilePosToMirrorUrl(const QGV::GeoTilePos& tilePos, int mirror) const override;
+
+private:
+    QStringList mBaseUrls;
+};
@@ -0,0 +1,26 @@
+CONFIG += testcase
+CONFIG -= app_bundle
+
+QT += gui widgets network testlib
+
+# refresh, paint and scene projShape bounds are checked only with counters in library
+qgv_debug_counters: DEFINES += QGV_DEBUG_COUNTERS
+
+PROJECT_SRC_ROOT = $$PWD/..
+PROJECT_BUILD_ROOT = $$OUT_PWD/..
+
+INCLUDEPATH += \
+    $$PROJECT_SRC_ROOT/lib/include/ \
+    $$PROJECT_SRC_ROOT/lib/include/QGeoView/
+
+CONFIG(release, debug|release): LIBS += -L$$PROJECT_BUILD_ROOT/lib/release
+CONFIG(debug, debug|release): LIBS += -L$$PROJECT_BUILD_ROOT/lib/debug
+LIBS += -L$$PROJECT_BUILD_ROOT/lib
+
+LIBS += -lqgeoview
+
+SOURCES += \
+    $$PWD/testitems.cpp
+
+HEADERS += \
+    $$PWD/testitems.h
@@ -0,0 +1,4 @@
+TEMPLATE = subdirs
+SUBDIRS = \
+    mapcounters.pro \
+    mirrors.pro
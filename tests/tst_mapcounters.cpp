@@ -0,0 +1,365 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "testitems.h"
+
+#include <QGeoView/QGVLayer.h>
+#include <QGeoView/QGVMap.h>
+#include <QGeoView/QGVMapQGView.h>
+#include <QGeoView/Raster/QGVIcon.h>
+#include <QGeoView/Raster/QGVIconRegistry.h>
+
+#include <QRandomGenerator>
+#include <QtMath>
+#include <QtTest>
+
+namespace {
+const QSize viewSize = QSize(800, 600);
+const int startZoom = 5;
+const int rectsCount = 10000;
+const int iconsCount = 2000;
+const QString iconKey = "test-icon";
+
+// projShape() is queried by scene for bounding rect, shape and paint of visible items
+const int shapeCallsPerItemAndFrame = 8;
+
+// viewport of 800x600 pixels is covered by at most 5x4 tiles of 256 pixels
+int tilesBound(int margin)
+{
+    return (5 + 2 * margin) * (4 + 2 * margin);
+}
+
+double zoomToScale(int zoom)
+{
+    // one tile pixel per one screen pixel, see QGVLayerTiles::scaleToZoom()
+    return qPow(2.0, zoom - 17);
+}
+
+QList<QGVDrawItem*> drawItems(QGVItem* layer)
+{
+    QList<QGVDrawItem*> result;
+    for (int index = 0; index < layer->countItems(); ++index) {
+        auto item = qobject_cast<QGVDrawItem*>(layer->getItem(index));
+        if (item != nullptr) {
+            result.append(item);
+        }
+    }
+    return result;
+}
+
+qint64 updateCount(QGVItem* layer)
+{
+    qint64 count = 0;
+    for (QGVDrawItem* item : drawItems(layer)) {
+        count += item->getUpdateCount();
+    }
+    return count;
+}
+
+qint64 paintCount(QGVItem* layer)
+{
+    qint64 count = 0;
+    for (QGVDrawItem* item : drawItems(layer)) {
+        count += item->getPaintCount();
+    }
+    return count;
+}
+
+qint64 shapeCount(QGVItem* layer)
+{
+    qint64 count = 0;
+    for (QGVDrawItem* item : drawItems(layer)) {
+        count += item->getShapeCount();
+    }
+    return count;
+}
+}
+
+/*!
+ * Upper bounds of refresh, projShape, paint and tile request counts for scripted camera moves.
+ * Refresh, paint and scene projShape counters are checked only when library is built with QGV_DEBUG_COUNTERS.
+ */
+class TestMapCounters : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void rectsPan();
+    void rectsZoom();
+    void iconsPan();
+    void iconsZoom();
+    void tilesSameCamera();
+    void tilesPan();
+    void tilesZoom();
+
+private:
+    QGVLayer* createRects();
+    QGVLayer* createIcons();
+    void cameraTo(int zoom, const QPointF& projCenter);
+    void panBy(double viewWidths, double viewHeights);
+    void zoomTo(int zoom);
+    void render();
+    int sceneItems() const;
+
+private:
+    QScopedPointer<QGVMap> mMap;
+};
+
+void TestMapCounters::init()
+{
+    mMap.reset(new QGVMap());
+    mMap->resize(viewSize);
+    mMap->show();
+    QVERIFY(QTest::qWaitForWindowExposed(mMap.data()));
+    const QPointF center = mMap->getProjection()->geoToProj(QGV::GeoPos(50, 10));
+    cameraTo(startZoom, center);
+}
+
+void TestMapCounters::cleanup()
+{
+    mMap.reset();
+    TestRect::resetShapeCalls();
+}
+
+void TestMapCounters::rectsPan()
+{
+    QGVLayer* layer = createRects();
+    render();
+    const qint64 updates = updateCount(layer);
+    const qint64 shapes = shapeCount(layer);
+    TestRect::resetShapeCalls();
+
+    const int frames = 8;
+    for (int step = 0; step < frames; ++step) {
+        panBy((step % 2 == 0) ? 0.5 : -0.5, 0.25);
+        render();
+    }
+
+    QCOMPARE(sceneItems(), rectsCount);
+    QVERIFY2(TestRect::shapeCalls() <= frames * rectsCount * shapeCallsPerItemAndFrame,
+             qPrintable(QString("projShape calls %1").arg(TestRect::shapeCalls())));
+#ifdef QGV_DEBUG_COUNTERS
+    // items without IgnoreScale or IgnoreAzimuth are not refreshed by camera
+    QCOMPARE(updateCount(layer) - updates, qint64(0));
+    QVERIFY(shapeCount(layer) - shapes <= qint64(frames) * rectsCount * shapeCallsPerItemAndFrame);
+#else
+    Q_UNUSED(updates);
+    Q_UNUSED(shapes);
+#endif
+}
+
+void TestMapCounters::rectsZoom()
+{
+    QGVLayer* layer = createRects();
+    render();
+    const qint64 updates = updateCount(layer);
+    const qint64 paints = paintCount(layer);
+    TestRect::resetShapeCalls();
+
+    const QList<int> zooms = { startZoom + 1, startZoom + 2, startZoom + 1, startZoom };
+    for (int zoom : zooms) {
+        zoomTo(zoom);
+        render();
+    }
+
+    const int frames = zooms.size();
+    QCOMPARE(sceneItems(), rectsCount);
+    QVERIFY2(TestRect::shapeCalls() <= frames * rectsCount * shapeCallsPerItemAndFrame,
+             qPrintable(QString("projShape calls %1").arg(TestRect::shapeCalls())));
+#ifdef QGV_DEBUG_COUNTERS
+    QCOMPARE(updateCount(layer) - updates, qint64(0));
+    // device coordinate cache of each item is repainted at most once per scale
+    QVERIFY(paintCount(layer) - paints <= qint64(frames) * rectsCount);
+#else
+    Q_UNUSED(updates);
+    Q_UNUSED(paints);
+#endif
+}
+
+void TestMapCounters::iconsPan()
+{
+    QGVLayer* layer = createIcons();
+    render();
+    const qint64 updates = updateCount(layer);
+
+    for (int step = 0; step < 8; ++step) {
+        panBy((step % 2 == 0) ? 0.5 : -0.5, 0.25);
+        render();
+    }
+
+    QCOMPARE(sceneItems(), iconsCount);
+#ifdef QGV_DEBUG_COUNTERS
+    // icons depend on scale and azimuth only
+    QCOMPARE(updateCount(layer) - updates, qint64(0));
+#else
+    Q_UNUSED(updates);
+    QSKIP("refresh counter requires QGV_DEBUG_COUNTERS");
+#endif
+}
+
+void TestMapCounters::iconsZoom()
+{
+    QGVLayer* layer = createIcons();
+    render();
+    const qint64 updates = updateCount(layer);
+    const qint64 paints = paintCount(layer);
+
+    const QList<int> zooms = { startZoom + 1, startZoom + 2, startZoom + 1, startZoom };
+    for (int zoom : zooms) {
+        zoomTo(zoom);
+        render();
+    }
+
+    const int frames = zooms.size();
+    QCOMPARE(sceneItems(), iconsCount);
+#ifdef QGV_DEBUG_COUNTERS
+    // each icon is refreshed once per scale change
+    QVERIFY(updateCount(layer) - updates <= qint64(frames) * iconsCount);
+    QVERIFY(paintCount(layer) - paints <= qint64(frames) * iconsCount);
+#else
+    Q_UNUSED(updates);
+    Q_UNUSED(paints);
+    QSKIP("refresh and paint counters require QGV_DEBUG_COUNTERS");
+#endif
+}
+
+void TestMapCounters::tilesSameCamera()
+{
+    auto tiles = new TestTiles();
+    mMap->addItem(tiles);
+    render();
+    QVERIFY(tiles->requests() > 0);
+    QVERIFY(tiles->requests() <= tilesBound(1));
+
+    tiles->resetCounters();
+    for (int step = 0; step < 4; ++step) {
+        cameraTo(startZoom, mMap->getCamera().projRect().center());
+        render();
+    }
+    QCOMPARE(tiles->requests(), 0);
+    QCOMPARE(tiles->cancels(), 0);
+}
+
+void TestMapCounters::tilesPan()
+{
+    auto tiles = new TestTiles();
+    mMap->addItem(tiles);
+    render();
+
+    const int steps = 8;
+    tiles->resetCounters();
+    for (int step = 0; step < steps; ++step) {
+        panBy(0.5, 0.0);
+        render();
+        // tiles outside of margin are removed
+        QVERIFY(sceneItems() <= tilesBound(3));
+    }
+    // tiles are answered immediately, so nothing is left to cancel
+    QCOMPARE(tiles->cancels(), 0);
+    QVERIFY2(tiles->requests() <= tilesBound(1) + steps * tilesBound(3) / 2,
+             qPrintable(QString("tile requests %1").arg(tiles->requests())));
+}
+
+void TestMapCounters::tilesZoom()
+{
+    auto tiles = new TestTiles();
+    mMap->addItem(tiles);
+    render();
+
+    const QList<int> zooms = { startZoom + 1, startZoom + 2, startZoom + 3, startZoom + 2 };
+    tiles->resetCounters();
+    for (int zoom : zooms) {
+        zoomTo(zoom);
+        render();
+        // lower tiles stay only at edges which are not covered by current zoom yet
+        QVERIFY(sceneItems() <= (zooms.size() + 1) * tilesBound(1));
+    }
+    QVERIFY2(tiles->requests() <= zooms.size() * tilesBound(1),
+             qPrintable(QString("tile requests %1").arg(tiles->requests())));
+}
+
+QGVLayer* TestMapCounters::createRects()
+{
+    // fixed seed keeps bounds reproducible
+    QRandomGenerator random(49);
+    const QRectF area = mMap->getCamera().projRect();
+    auto layer = new QGVLayer();
+    for (int index = 0; index < rectsCount; ++index) {
+        const QPointF pos = QPointF(area.left() + random.bounded(area.width()),
+                                    area.top() + random.bounded(area.height()));
+        const QRectF projRect = QRectF(pos, area.size() / 50);
+        layer->addItem(new TestRect(mMap->getProjection()->projToGeo(projRect)));
+    }
+    mMap->addItem(layer);
+    return layer;
+}
+
+QGVLayer* TestMapCounters::createIcons()
+{
+    QImage image(16, 16, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::blue);
+    QGVIconRegistry::instance()->add(iconKey, image);
+
+    QRandomGenerator random(49);
+    const QRectF area = mMap->getCamera().projRect();
+    auto layer = new QGVLayer();
+    for (int index = 0; index < iconsCount; ++index) {
+        const QPointF pos = QPointF(area.left() + random.bounded(area.width()),
+                                    area.top() + random.bounded(area.height()));
+        auto icon = new QGVIcon();
+        icon->setGeometry(pos, QSizeF(16, 16));
+        icon->loadIcon(iconKey);
+        layer->addItem(icon);
+    }
+    mMap->addItem(layer);
+    return layer;
+}
+
+void TestMapCounters::cameraTo(int zoom, const QPointF& projCenter)
+{
+    mMap->cameraTo(QGVCameraActions(mMap.data()).scaleTo(zoomToScale(zoom)).moveTo(projCenter));
+}
+
+void TestMapCounters::panBy(double viewWidths, double viewHeights)
+{
+    const QRectF projRect = mMap->getCamera().projRect();
+    const QPointF center = projRect.center() + QPointF(projRect.width() * viewWidths, projRect.height() * viewHeights);
+    cameraTo(startZoom, center);
+}
+
+void TestMapCounters::zoomTo(int zoom)
+{
+    cameraTo(zoom, mMap->getCamera().projRect().center());
+}
+
+void TestMapCounters::render()
+{
+    QCoreApplication::processEvents();
+    mMap->geoView()->viewport()->repaint();
+}
+
+int TestMapCounters::sceneItems() const
+{
+    return mMap->geoView()->scene()->items().size();
+}
+
+QTEST_MAIN(TestMapCounters)
+#include "tst_mapcounters.moc"
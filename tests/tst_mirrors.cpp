@@ -0,0 +1,202 @@
+/***************************************************************************
+ * QGeoView is a Qt / C ++ widget for visualizing geographic data.
+ * Copyright (C) 2018-2024 Andrey Yaroshenko.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, see https://www.gnu.org/licenses.
+ ****************************************************************************/
+
+#include "stubserver.h"
+#include "testitems.h"
+
+#include <QGeoView/QGVMap.h>
+
+#include <QNetworkAccessManager>
+#include <QtMath>
+#include <QtTest>
+
+namespace {
+const QSize viewSize = QSize(800, 600);
+const int startZoom = 3;
+const int serversCount = 3;
+const int loadTimeoutMs = 10000;
+
+// replies of slow host are delayed much longer than hedging needs to win
+const int slowDelayMs = 3000;
+const int hedgedLoadTimeoutMs = 2000;
+
+double zoomToScale(int zoom)
+{
+    return qPow(2.0, zoom - 17);
+}
+}
+
+/*!
+ * Spreading of tile requests over mirrors, avoiding of failing host and hedging of slow requests,
+ * checked against local stub servers.
+ */
+class TestMirrors : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void mirrorsDisabled();
+    void roundRobin();
+    void avoidFailingHost();
+    void hedgeSlowHost();
+
+private:
+    TestMirrorTiles* createLayer();
+    void zoomTo(int zoom);
+    bool isLoaded(TestMirrorTiles* layer) const;
+    int totalRequests() const;
+    void resetRequests();
+
+private:
+    QScopedPointer<QGVMap> mMap;
+    QScopedPointer<QNetworkAccessManager> mManager;
+    QList<StubServer*> mServers;
+};
+
+void TestMirrors::init()
+{
+    for (int index = 0; index < serversCount; ++index) {
+        auto server = new StubServer(this);
+        QVERIFY(server->listen());
+        mServers.append(server);
+    }
+    mManager.reset(new QNetworkAccessManager());
+
+    mMap.reset(new QGVMap());
+    mMap->resize(viewSize);
+    mMap->show();
+    QVERIFY(QTest::qWaitForWindowExposed(mMap.data()));
+    zoomTo(startZoom);
+}
+
+void TestMirrors::cleanup()
+{
+    mMap.reset();
+    mManager.reset();
+    qDeleteAll(mServers);
+    mServers.clear();
+}
+
+void TestMirrors::mirrorsDisabled()
+{
+    auto layer = createLayer();
+    QTRY_VERIFY_WITH_TIMEOUT(isLoaded(layer), loadTimeoutMs);
+
+    QVERIFY(mServers[0]->requests() > 0);
+    for (int index = 1; index < serversCount; ++index) {
+        QCOMPARE(mServers[index]->requests(), 0);
+    }
+}
+
+void TestMirrors::roundRobin()
+{
+    auto layer = createLayer();
+    layer->setMirrorsEnabled(true);
+    QTRY_VERIFY_WITH_TIMEOUT(isLoaded(layer), loadTimeoutMs);
+
+    // healthy hosts of equal speed get similar share of requests
+    const int total = totalRequests();
+    QVERIFY(total > 0);
+    for (StubServer* server : mServers) {
+        QVERIFY2(server->requests() >= total / (2 * serversCount),
+                 qPrintable(QString("%1 of %2 requests").arg(server->requests()).arg(total)));
+    }
+}
+
+void TestMirrors::avoidFailingHost()
+{
+    StubServer* failing = mServers[1];
+    failing->setStatus(500);
+    auto layer = createLayer();
+    layer->setMirrorsEnabled(true);
+    QTRY_VERIFY_WITH_TIMEOUT(isLoaded(layer), loadTimeoutMs);
+
+    // health of hosts is known now, failing one gets only probes
+    resetRequests();
+    zoomTo(startZoom + 1);
+    QTRY_VERIFY_WITH_TIMEOUT(isLoaded(layer), loadTimeoutMs);
+
+    const int total = totalRequests();
+    QVERIFY(total > 0);
+    QVERIFY2(failing->requests() <= total / 4,
+             qPrintable(QString("%1 of %2 requests").arg(failing->requests()).arg(total)));
+}
+
+void TestMirrors::hedgeSlowHost()
+{
+    auto layer = createLayer();
+    layer->setMirrorsEnabled(true);
+    layer->setHedgePercentile(0.9);
+    QTRY_VERIFY_WITH_TIMEOUT(isLoaded(layer), loadTimeoutMs);
+
+    // latency of first host goes up before its median does, so it still gets requests
+    StubServer* slow = mServers[0];
+    slow->setDelayMs(slowDelayMs);
+    resetRequests();
+    zoomTo(startZoom + 1);
+    QTRY_VERIFY_WITH_TIMEOUT(isLoaded(layer), hedgedLoadTimeoutMs);
+    QVERIFY(slow->requests() > 0);
+}
+
+TestMirrorTiles* TestMirrors::createLayer()
+{
+    QStringList baseUrls;
+    for (StubServer* server : mServers) {
+        baseUrls.append(server->baseUrl());
+    }
+    auto layer = new TestMirrorTiles(baseUrls);
+    layer->setCache(false);
+    layer->setHttp2(false);
+    layer->setAutoOffline(false);
+    layer->setNetworkManager(mManager.data());
+    mMap->addItem(layer);
+    return layer;
+}
+
+void TestMirrors::zoomTo(int zoom)
+{
+    const QPointF center = mMap->getProjection()->geoToProj(QGV::GeoPos(50, 10));
+    mMap->cameraTo(QGVCameraActions(mMap.data()).scaleTo(zoomToScale(zoom)).moveTo(center));
+}
+
+bool TestMirrors::isLoaded(TestMirrorTiles* layer) const
+{
+    return layer->countPendingTiles() == 0 && layer->countRequestsInFlight() == 0;
+}
+
+int TestMirrors::totalRequests() const
+{
+    int total = 0;
+    for (StubServer* server : mServers) {
+        total += server->requests();
+    }
+    return total;
+}
+
+void TestMirrors::resetRequests()
+{
+    for (StubServer* server : mServers) {
+        server->resetRequests();
+    }
+}
+
+QTEST_MAIN(TestMirrors)
+#include "tst_mirrors.moc"